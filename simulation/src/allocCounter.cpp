@@ -0,0 +1,98 @@
+//--------------------------------------------------
+// Box Pushing
+// allocCounter.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "allocCounter.h"
+#include <algorithm>
+#include <atomic>
+#include <dlfcn.h>
+
+namespace AllocCounter {
+
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    std::atomic<uint64_t> numAllocations = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        numAllocations.fetch_add(1, std::memory_order_relaxed);
+        Scope untagged(NUM_SUBSYSTEMS); // Already counted, not again by the heap hook
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override { std::pmr::new_delete_resource()->deallocate(p, bytes, alignment); }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+std::array<CountingResource, NUM_SUBSYSTEMS> resources;
+std::array<std::atomic<uint64_t>, NUM_SUBSYSTEMS> heapAllocations = {}; // Counted by countHeapAllocation
+thread_local Subsystem currentScope = NUM_SUBSYSTEMS;
+std::array<Report, NUM_SUBSYSTEMS> reports = {};
+std::array<uint64_t, NUM_SUBSYSTEMS> stepStart = {}; // Allocation count at the beginning of the step
+uint64_t numSteps = 0;
+uint64_t warmup = 10;
+// Set by the preloaded alloc_hook library, cleared when this library is unloaded (the hook would point to unloaded code)
+using SetHook = void (*)(void (*)());
+SetHook setHeapHook = nullptr;
+struct HeapHookGuard {
+    ~HeapHookGuard() {
+        if (setHeapHook)
+            setHeapHook(nullptr);
+    }
+} heapHookGuard;
+
+uint64_t numAllocations(unsigned subsystem) {
+    return resources[subsystem].numAllocations.load(std::memory_order_relaxed) + heapAllocations[subsystem].load(std::memory_order_relaxed);
+}
+
+} // namespace AllocCounter
+
+std::pmr::memory_resource* AllocCounter::getResource(Subsystem subsystem) { return &resources[subsystem]; }
+
+AllocCounter::Scope::Scope(Subsystem subsystem) : _previous(currentScope) { currentScope = subsystem; }
+
+AllocCounter::Scope::~Scope() { currentScope = _previous; }
+
+void AllocCounter::countHeapAllocation() {
+    if (currentScope != NUM_SUBSYSTEMS)
+        heapAllocations[currentScope].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocCounter::onStep() {
+    for (unsigned i = 0; i < NUM_SUBSYSTEMS; i++) {
+        uint64_t count = numAllocations(i);
+        uint64_t step = count - stepStart[i];
+        stepStart[i] = count;
+
+        Report& r = reports[i];
+        r.lastStep = step;
+        r.total += step;
+        r.maxPerStep = std::max(r.maxPerStep, step);
+        if (numSteps >= warmup)
+            r.steadyState += step;
+    }
+    numSteps++;
+}
+
+void AllocCounter::reset(uint64_t warmupSteps) {
+    setHeapHook = reinterpret_cast<SetHook>(dlsym(RTLD_DEFAULT, "boxPushingSetAllocHook"));
+    if (setHeapHook)
+        setHeapHook(&countHeapAllocation);
+    for (unsigned i = 0; i < NUM_SUBSYSTEMS; i++) {
+        stepStart[i] = numAllocations(i);
+        reports[i] = {};
+    }
+    numSteps = 0;
+    warmup = warmupSteps;
+}
+
+AllocCounter::Report AllocCounter::getReport(Subsystem subsystem) { return reports[subsystem]; }
+
+bool AllocCounter::isSteadyStateAllocationFree() {
+    for (const Report& r : reports)
+        if (r.steadyState > 0)
+            return false;
+    return true;
+}
+
+bool AllocCounter::isHeapHookInstalled() { return setHeapHook != nullptr; }
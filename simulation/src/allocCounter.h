@@ -0,0 +1,61 @@
+//--------------------------------------------------
+// Box Pushing
+// allocCounter.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+
+namespace AllocCounter {
+
+enum Subsystem : uint32_t {
+    VISION = 0,
+    CONTROL,
+    TELEOP,
+    NUM_SUBSYSTEMS,
+};
+inline const std::array<const char*, NUM_SUBSYSTEMS> subsystemNames = {"vision", "control", "teleop"};
+
+// Memory resource of each subsystem. Every allocation that reaches the heap through it is counted, so containers in the
+// control loop should be created with it (std::pmr) and keep their capacity across frames
+std::pmr::memory_resource* getResource(Subsystem subsystem);
+
+// Tags the code running on this thread with a subsystem until destroyed (scopes nest, the previous tag is restored)
+class Scope {
+  public:
+    explicit Scope(Subsystem subsystem);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    Subsystem _previous;
+};
+// Counts a heap allocation for the subsystem of the current scope (ignored outside of scopes). Called by the global
+// operator new of the alloc_hook library (tests/allocHook.cpp) when it is preloaded, so allocations that bypass the resources
+// (atta calls, strings, temporary containers) are also counted
+void countHeapAllocation();
+// If the alloc_hook library is preloaded. Otherwise only the allocations through the resources are counted
+bool isHeapHookInstalled();
+
+struct Report {
+    uint64_t total = 0;       // Allocations since reset
+    uint64_t steadyState = 0; // Allocations after the warm-up steps
+    uint64_t maxPerStep = 0;
+    uint64_t lastStep = 0; // Allocations in the last finished step
+};
+
+// Called once per simulation step to close the step counters
+void onStep();
+// Also installs the heap hook if the alloc_hook library is preloaded
+void reset(uint64_t warmupSteps = 10);
+Report getReport(Subsystem subsystem);
+// Returns false if any subsystem allocated after the warm-up steps
+bool isSteadyStateAllocationFree();
+
+} // namespace AllocCounter
+
+#endif // ALLOC_COUNTER_H
@@ -0,0 +1,146 @@
+//--------------------------------------------------
+// Box Pushing
+// chainAnalysis.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "chainAnalysis.h"
+#include "common.h"
+#include "pusherComponent.h"
+#include <algorithm>
+#include <atta/component/components/transform.h>
+#include <atta/utils/config.h>
+#include <cmath>
+
+namespace ChainAnalysis {
+
+Settings settings;
+
+// Walls in their own frame, to test segments against axis aligned boxes
+struct Wall {
+    atta::vec2 pos;
+    atta::vec2 half;
+    float cos, sin;
+};
+std::vector<Wall> walls;
+std::vector<cmp::Entity> pushers;
+
+// Nodes: 0 is the goal, 1 is the object, then the sub-goal pushers of this step
+std::vector<atta::vec2> nodes;
+std::vector<uint32_t> previous; // Node before each one in the breadth-first search from the object, unvisited if none
+std::vector<uint32_t> queue;
+constexpr uint32_t unvisited = UINT32_MAX;
+
+Report report;
+double lengthSum = 0.0; // Sum of the chain length over the connected steps
+uint64_t numConnectedSteps = 0;
+
+// If the segment a-b crosses the wall box (slab test in the wall frame)
+bool blocks(const Wall& w, atta::vec2 a, atta::vec2 b) {
+    auto toWall = [&](atta::vec2 p) {
+        p = p - w.pos;
+        return atta::vec2(w.cos * p.x + w.sin * p.y, -w.sin * p.x + w.cos * p.y);
+    };
+    const atta::vec2 p = toWall(a);
+    const atta::vec2 d = toWall(b) - p;
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    for (int axis = 0; axis < 2; axis++) {
+        const float o = axis == 0 ? p.x : p.y;
+        const float v = axis == 0 ? d.x : d.y;
+        const float h = axis == 0 ? w.half.x : w.half.y;
+        if (std::abs(v) < 1e-9f) {
+            if (std::abs(o) > h)
+                return false;
+            continue;
+        }
+        float t0 = (-h - o) / v;
+        float t1 = (h - o) / v;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax)
+            return false;
+    }
+    return true;
+}
+
+bool visible(atta::vec2 a, atta::vec2 b) {
+    if ((b - a).length() > settings.viewRange)
+        return false;
+    for (const Wall& w : walls)
+        if (blocks(w, a, b))
+            return false;
+    return true;
+}
+
+} // namespace ChainAnalysis
+
+ChainAnalysis::Settings& ChainAnalysis::getSettings() { return settings; }
+
+void ChainAnalysis::start(const std::vector<WallInfo>& mapWalls) {
+    walls.clear();
+    for (const WallInfo& w : mapWalls)
+        walls.push_back({w.pos, w.size * 0.5f, std::cos(w.angle), std::sin(w.angle)});
+    pushers = cmp::getFactory(pusherProto)->getClones();
+    nodes.reserve(pushers.size() + 2);
+    previous.reserve(pushers.size() + 2);
+    queue.reserve(pushers.size() + 2);
+
+    report = Report{};
+    lengthSum = 0.0;
+    numConnectedSteps = 0;
+}
+
+void ChainAnalysis::update() {
+    if (!settings.enabled)
+        return;
+
+    // Build the nodes
+    nodes.clear();
+    nodes.push_back(atta::vec2(goal.get<cmp::Transform>()->position));
+    nodes.push_back(atta::vec2(object.get<cmp::Transform>()->position));
+    for (cmp::Entity pusher : pushers) {
+        PusherComponent* pc = pusher.get<PusherComponent>();
+        if (pc->state == PusherComponent::BE_A_GOAL && pc->task() == 0)
+            nodes.push_back(atta::vec2(pusher.get<cmp::Transform>()->position));
+    }
+
+    // Shortest path from the object to the goal. The object-goal link is not part of a chain, so the goal can only be reached
+    // from a sub-goal pusher
+    previous.assign(nodes.size(), unvisited);
+    queue.clear();
+    queue.push_back(1);
+    previous[1] = 1;
+    for (size_t q = 0; q < queue.size() && previous[0] == unvisited; q++) {
+        const uint32_t i = queue[q];
+        for (uint32_t j = i == 1 ? 2 : 0; j < nodes.size(); j++)
+            if (previous[j] == unvisited && visible(nodes[i], nodes[j])) {
+                previous[j] = i;
+                queue.push_back(j);
+            }
+    }
+
+    // Sub-goal pushers on the path
+    const bool connected = previous[0] != unvisited;
+    uint32_t length = 0;
+    if (connected)
+        for (uint32_t i = previous[0]; i != 1; i = previous[i])
+            length++;
+
+    const float time = atta::Config::getTime();
+    if (connected) {
+        if (std::isnan(report.firstChainTime))
+            report.firstChainTime = time;
+        report.maxLength = std::max(report.maxLength, length);
+        report.connectedTime += atta::Config::getDt();
+        lengthSum += length;
+        numConnectedSteps++;
+    } else if (report.connected)
+        report.numBreakages++;
+    report.connected = connected;
+    report.currentLength = length;
+    report.meanLength = numConnectedSteps ? lengthSum / numConnectedSteps : 0.0f;
+}
+
+ChainAnalysis::Report ChainAnalysis::getReport() { return report; }
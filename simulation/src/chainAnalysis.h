@@ -0,0 +1,43 @@
+//--------------------------------------------------
+// Box Pushing
+// chainAnalysis.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef CHAIN_ANALYSIS_H
+#define CHAIN_ANALYSIS_H
+#include "mapInfo.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Sub-goal chain detection. Every step the visibility graph among the goal, the BE_A_GOAL pushers and the object is built
+// (two nodes are linked when they are in view range and no wall blocks the segment between them) and searched breadth-first
+// from the object. A chain is connected when the goal is reached through at least one sub-goal pusher; its length is the
+// number of sub-goal pushers on the shortest such path. Only the first object/goal pair is analyzed
+namespace ChainAnalysis {
+
+struct Settings {
+    bool enabled = true;
+    float viewRange = 2.0f; // Farther nodes are not linked (m)
+};
+Settings& getSettings();
+
+// Should be called when the simulation starts, with the walls of the current map
+void start(const std::vector<WallInfo>& walls);
+// Updates the chain with the current step. Should be called once per simulation step
+void update();
+
+struct Report {
+    float firstChainTime = NAN; // Time of the first connected chain
+    uint32_t numBreakages = 0;  // Connected chains that got disconnected
+    uint32_t maxLength = 0;     // Longest connected chain
+    float meanLength = 0.0f;    // Mean length while connected
+    float connectedTime = 0.0f; // Time with a connected chain (s)
+    uint32_t currentLength = 0; // Chain length at the last step (0 if not connected)
+    bool connected = false;     // If the chain was connected at the last step
+};
+Report getReport();
+
+} // namespace ChainAnalysis
+
+#endif // CHAIN_ANALYSIS_H
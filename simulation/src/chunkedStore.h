@@ -0,0 +1,49 @@
+//--------------------------------------------------
+// Box Pushing
+// chunkedStore.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef CHUNKED_STORE_H
+#define CHUNKED_STORE_H
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Per-entity storage that grows in fixed-size chunks. Elements never move, so references stay valid while it grows, and
+// growing only allocates the new chunk
+template <typename T, size_t ChunkSize = 256>
+class ChunkedStore {
+  public:
+    ChunkedStore(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : _resource(resource), _chunks(resource) {}
+    ~ChunkedStore() { clear(); }
+    ChunkedStore(const ChunkedStore&) = delete;
+    ChunkedStore& operator=(const ChunkedStore&) = delete;
+
+    T& operator[](size_t idx) {
+        size_t chunk = idx / ChunkSize;
+        while (chunk >= _chunks.size()) {
+            T* data = static_cast<T*>(_resource->allocate(sizeof(T) * ChunkSize, alignof(T)));
+            for (size_t i = 0; i < ChunkSize; i++)
+                new (data + i) T();
+            _chunks.push_back(data);
+        }
+        return _chunks[chunk][idx % ChunkSize];
+    }
+
+    size_t capacity() const { return _chunks.size() * ChunkSize; }
+
+    void clear() {
+        for (T* data : _chunks) {
+            for (size_t i = 0; i < ChunkSize; i++)
+                data[i].~T();
+            _resource->deallocate(data, sizeof(T) * ChunkSize, alignof(T));
+        }
+        _chunks.clear();
+    }
+
+  private:
+    std::pmr::memory_resource* _resource;
+    std::pmr::vector<T*> _chunks;
+};
+
+#endif // CHUNKED_STORE_H
@@ -5,10 +5,12 @@
 //--------------------------------------------------
 #ifndef COMMON_H
 #define COMMON_H
+#include <array>
 #include <atta/component/interface.h>
 
 namespace cmp = atta::component;
 
+cmp::Entity ground(0);
 cmp::Entity obstacles(1);
 cmp::Entity pusherProto(7);
 cmp::Entity object(8);
@@ -27,4 +29,11 @@ inline const Color goalColor(0, 255, 0);
 inline const Color objectColor(255, 0, 0);
 inline const Color pusherColor(0, 0, 255);
 
+// Object/goal pairs (tasks). Each pair has its own colors, the first one is the scene object and goal
+constexpr unsigned maxTasks = 4;
+inline const std::array<Color, maxTasks> objectColors = {objectColor, Color(255, 0, 255), Color(255, 255, 0), Color(255, 128, 0)};
+inline const std::array<Color, maxTasks> goalColors = {goalColor, Color(0, 255, 255), Color(128, 255, 128), Color(0, 128, 0)};
+inline const std::array<const char*, maxTasks> objectMaterials = {"object", "object1", "object2", "object3"};
+inline const std::array<const char*, maxTasks> goalMaterials = {"goal", "goal1", "goal2", "goal3"};
+
 #endif // COMMON_H
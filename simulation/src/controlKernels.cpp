@@ -0,0 +1,25 @@
+//--------------------------------------------------
+// Box Pushing
+// controlKernels.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "controlKernels.h"
+
+void ControlKernels::computeDriveBatch(size_t n, const float* dirX, const float* dirY, const float* heading, float* linVel, float* angVel,
+                                       float* velX, float* velY) {
+    // With the unit direction (x, y) the motor powers are maxPwr * (x - y, x + y) / sqrt(2), so
+    //   linVel = wheelR * maxPwr * x / sqrt(2)
+    //   angVel = -wheelR / wheelD * maxPwr * sqrt(2) * y
+    constexpr float linGain = wheelR * maxPwr * float(M_SQRT1_2);
+    constexpr float angGain = -wheelR / wheelD * maxPwr * float(M_SQRT2);
+    for (size_t i = 0; i < n; i++) {
+        float len2 = dirX[i] * dirX[i] + dirY[i] * dirY[i];
+        float invLen = len2 > 0.0f ? 1.0f / std::sqrt(len2) : 0.0f; // Zero direction breaks motors
+        linVel[i] = linGain * dirX[i] * invLen;
+        angVel[i] = angGain * dirY[i] * invLen;
+    }
+    for (size_t i = 0; i < n; i++) {
+        velX[i] = linVel[i] * std::cos(heading[i]);
+        velY[i] = linVel[i] * std::sin(heading[i]);
+    }
+}
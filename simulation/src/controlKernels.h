@@ -0,0 +1,94 @@
+//--------------------------------------------------
+// Box Pushing
+// controlKernels.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef CONTROL_KERNELS_H
+#define CONTROL_KERNELS_H
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// Image and kinematics kernels of the pusher control loop, they do not depend on atta
+namespace ControlKernels {
+
+constexpr float wheelD = 0.06f; // Wheel distance
+constexpr float wheelR = 0.01f; // Wheel radius
+constexpr float maxPwr = 50.0f; // Motor maximum power (max 0.5m/s)
+
+using Intervals = std::pmr::vector<std::pair<int, int>>;
+
+// Direction (rad, 0 to the front) of the largest run of matching pixels in a row that spans 360 degrees, NaN if no pixel
+// matches. isColor(x) tells if pixel x matches. The intervals should be reserved for rowSize / 2 + 1 runs
+template <typename IsColor>
+float largestIntervalDirection(unsigned rowSize, IsColor isColor, Intervals& intervals) {
+    // Calculate intervals
+    intervals.clear();
+    int start = -1;
+    int end = -1;
+    for (unsigned i = 0; i < rowSize; i++) {
+        if (!isColor(i)) {
+            if (start != end)
+                intervals.push_back({start + 1, end});
+            start = i;
+            end = i;
+        } else
+            end = i;
+    }
+    if (start != end)
+        intervals.push_back({start + 1, end});
+
+    // If could not find color, return NaN
+    if (intervals.empty())
+        return NAN;
+
+    // Merge intervals
+    if (intervals.size() > 1 && intervals.front().first == 0 && intervals.back().second == int(rowSize) - 1) {
+        intervals.front().first = intervals.back().first;
+        intervals.pop_back();
+    }
+
+    // Find largest interval
+    unsigned idxLargest = -1;
+    unsigned sizeLargest = 0;
+    for (unsigned i = 0; i < intervals.size(); i++) {
+        int start = intervals[i].first;
+        int end = intervals[i].second;
+
+        // Calculate size
+        unsigned size = 0;
+        if (start <= end)
+            size = end - start + 1;
+        else
+            size = (rowSize - start) + end + 1;
+
+        // Update largest
+        if (size >= sizeLargest) {
+            idxLargest = i;
+            sizeLargest = size;
+        }
+    }
+
+    // Calculate direction to largest interval
+    auto interval = intervals[idxLargest];
+    // Calculate mean pixel position
+    int pixelPos = (interval.first + sizeLargest / 2) % rowSize;
+    // Convert to [0,1]
+    float meanPos = pixelPos / float(rowSize);
+    // Convert to [-2, 2] (and rotate so 0.0 is to the front)
+    meanPos = (meanPos * 4 - 0.5);
+    if (meanPos > 2)
+        meanPos = -2 + (meanPos - 2);
+    // Return direction
+    return meanPos * M_PI * 0.5;
+}
+
+// Differential drive kinematics from unit direction vectors (robot frame), also outputs the world frame linear velocity
+// given the robot heading. A zero direction breaks the motors
+void computeDriveBatch(size_t n, const float* dirX, const float* dirY, const float* heading, float* linVel, float* angVel, float* velX, float* velY);
+
+} // namespace ControlKernels
+
+#endif // CONTROL_KERNELS_H
@@ -0,0 +1,64 @@
+//--------------------------------------------------
+// Box Pushing
+// controllerParams.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef CONTROLLER_PARAMS_H
+#define CONTROLLER_PARAMS_H
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <array>
+
+// Tunable constants of the pusher state machine. The defaults are the hand-picked values of the paper. This header does
+// not depend on atta, so the parameter optimizer tool shares the names and ranges with the simulation
+namespace ControllerParams {
+
+struct Params {
+    float randomWalkNoise = 2.0f;    // Random walk direction noise, Unif(-a, a) per second
+    float randomWalkMaxDir = 0.2f;   // Random walk direction limit (rad)
+    float minCamDist = 0.15f;        // Camera distance to the object to stop approaching
+    float minIrDist = 0.1f;          // Infrared distance to the object to stop approaching
+    float minAngle = 0.15f;          // The front angle interval is [-minAngle, minAngle]
+    float keepCamDist = 0.2f;        // Camera distance kept from the object when moving around it
+    float keepIrDist = 0.2f;         // Infrared distance kept from the object when moving around it
+    float pushObjectTimeout = 60.0f; // Time moving around/pushing the object before giving up (s)
+    float beAGoalMaxWait = 5.0f;     // Maximum wait before being a goal again (s)
+};
+
+struct Info {
+    const char* name;
+    float Params::*member;
+    float min; // Search range
+    float max;
+};
+inline const std::array<Info, 9> infos = {{
+    {"randomWalkNoise", &Params::randomWalkNoise, 0.5f, 5.0f},
+    {"randomWalkMaxDir", &Params::randomWalkMaxDir, 0.05f, 0.6f},
+    {"minCamDist", &Params::minCamDist, 0.05f, 0.4f},
+    {"minIrDist", &Params::minIrDist, 0.02f, 0.3f},
+    {"minAngle", &Params::minAngle, 0.05f, 0.5f},
+    {"keepCamDist", &Params::keepCamDist, 0.05f, 0.5f},
+    {"keepIrDist", &Params::keepIrDist, 0.05f, 0.5f},
+    {"pushObjectTimeout", &Params::pushObjectTimeout, 10.0f, 180.0f},
+    {"beAGoalMaxWait", &Params::beAGoalMaxWait, 0.0f, 20.0f},
+}};
+
+inline nlohmann::json toJson(const Params& params) {
+    nlohmann::json json = {};
+    for (const Info& info : infos)
+        json[info.name] = params.*info.member;
+    return json;
+}
+
+// Missing parameters keep their default, values are clamped to the search range
+inline Params fromJson(const nlohmann::json& json) {
+    Params params;
+    for (const Info& info : infos)
+        if (json.contains(info.name) && json[info.name].is_number())
+            params.*info.member = std::clamp(json[info.name].get<float>(), info.min, info.max);
+    return params;
+}
+
+} // namespace ControllerParams
+
+#endif // CONTROLLER_PARAMS_H
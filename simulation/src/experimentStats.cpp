@@ -0,0 +1,66 @@
+//--------------------------------------------------
+// Box Pushing
+// experimentStats.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "experimentStats.h"
+#include <algorithm>
+#include <cmath>
+
+ExperimentStats::Interval ExperimentStats::successRateInterval(int numSuccesses, int numTrials, float z) {
+    if (numTrials <= 0)
+        return {0.0f, 1.0f};
+    const float n = numTrials;
+    const float p = numSuccesses / n;
+    const float z2 = z * z;
+    const float center = (p + z2 / (2 * n)) / (1 + z2 / n);
+    const float halfWidth = z / (1 + z2 / n) * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+    return {std::max(0.0f, center - halfWidth), std::min(1.0f, center + halfWidth)};
+}
+
+float ExperimentStats::median(std::vector<float> samples) {
+    if (samples.empty())
+        return NAN;
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    return n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) * 0.5f;
+}
+
+ExperimentStats::Interval ExperimentStats::medianInterval(std::vector<float> samples, float z) {
+    if (samples.empty())
+        return {NAN, NAN};
+    std::sort(samples.begin(), samples.end());
+    const int n = samples.size();
+    // Ranks (1-based) of the order statistics bounding the median
+    int lowRank = std::floor(n * 0.5f - z * std::sqrt(float(n)) * 0.5f);
+    int highRank = std::ceil(n * 0.5f + 1 + z * std::sqrt(float(n)) * 0.5f);
+    lowRank = std::clamp(lowRank, 1, n);
+    highRank = std::clamp(highRank, 1, n);
+    return {samples[lowRank - 1], samples[highRank - 1]};
+}
+
+bool ExperimentStats::shouldStop(const StoppingRule& rule, int numTrials, const std::vector<float>& successTimes, std::string& reason) {
+    if (numTrials >= rule.maxRepetitions) {
+        reason = "maxRepetitions";
+        return true;
+    }
+    if (numTrials < rule.minRepetitions)
+        return false;
+
+    // Success rate
+    const int numSuccesses = successTimes.size();
+    if (successRateInterval(numSuccesses, numTrials, rule.z).width() > rule.successRateWidth)
+        return false;
+
+    // Median completion time (only meaningful if the configuration succeeds)
+    if (numSuccesses > 0) {
+        if (numSuccesses < rule.minSuccessesForTime)
+            return false;
+        Interval time = medianInterval(successTimes, rule.z);
+        if (time.width() > rule.medianTimeWidth * median(successTimes))
+            return false;
+    }
+
+    reason = "confidenceInterval";
+    return true;
+}
@@ -0,0 +1,41 @@
+//--------------------------------------------------
+// Box Pushing
+// experimentStats.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef EXPERIMENT_STATS_H
+#define EXPERIMENT_STATS_H
+#include <string>
+#include <vector>
+
+namespace ExperimentStats {
+
+struct Interval {
+    float low;
+    float high;
+    float width() const { return high - low; }
+};
+
+// Sequential stopping rule used by the adaptive experiment mode. A configuration stops once both intervals are tighter
+// than their targets (or maxRepetitions is reached), but never before minRepetitions
+struct StoppingRule {
+    int minRepetitions = 10;
+    int maxRepetitions = 50;
+    float z = 1.96f;                // Normal quantile of the confidence level (1.96 -> 95%)
+    float successRateWidth = 0.2f;  // Maximum width of the success rate interval
+    float medianTimeWidth = 0.2f;   // Maximum width of the median time interval, relative to the median
+    int minSuccessesForTime = 5;    // Minimum number of successes before evaluating the median time interval
+};
+
+// Wilson score interval for a binomial proportion
+Interval successRateInterval(int numSuccesses, int numTrials, float z);
+// Distribution-free interval for the median based on order statistics (normal approximation of the ranks)
+Interval medianInterval(std::vector<float> samples, float z);
+float median(std::vector<float> samples);
+
+// Returns true when the stopping rule is satisfied, filling reason with a short description of why
+bool shouldStop(const StoppingRule& rule, int numTrials, const std::vector<float>& successTimes, std::string& reason);
+
+} // namespace ExperimentStats
+
+#endif // EXPERIMENT_STATS_H
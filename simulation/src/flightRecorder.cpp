@@ -0,0 +1,125 @@
+//--------------------------------------------------
+// Box Pushing
+// flightRecorder.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "flightRecorder.h"
+#include "common.h"
+#include "pusherComponent.h"
+#include <algorithm>
+#include <atta/component/components/transform.h>
+#include <atta/utils/config.h>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+namespace FlightRecorder {
+
+Settings settings;
+
+std::vector<cmp::Entity> pushers;
+std::vector<FrameHeader> frames;  // Ring buffer of frames
+std::vector<RobotSample> samples; // Ring buffer of samples, numRobots per frame
+size_t capacity = 0;              // Frames
+size_t head = 0;                  // Next frame to write
+size_t numFrames = 0;
+
+// Stall detection
+float anchorTime = 0.0f;
+float anchorX = 0.0f;
+float anchorY = 0.0f;
+bool stallTriggered = false;
+bool stallReported = false;
+
+} // namespace FlightRecorder
+
+FlightRecorder::Settings& FlightRecorder::getSettings() { return settings; }
+
+void FlightRecorder::capture(const std::vector<cmp::Entity>& pushers, FrameHeader& frame, RobotSample* samples) {
+    cmp::Transform* objT = object.get<cmp::Transform>();
+    frame = {atta::Config::getTime(), objT->position.x, objT->position.y, objT->orientation.get2DAngle()};
+
+    RobotSample* s = samples;
+    for (cmp::Entity pusher : pushers) {
+        cmp::Transform* t = pusher.get<cmp::Transform>();
+        PusherComponent* pc = pusher.get<PusherComponent>();
+        s->x = t->position.x;
+        s->y = t->position.y;
+        s->angle = t->orientation.get2DAngle();
+        s->state = pc->state;
+        s->flags = pc->flags;
+        s->entity = pusher.getId();
+        s->objectDirection = pc->objectDirection;
+        s->objectDistance = pc->objectDistance;
+        s->goalDirection = pc->goalDirection;
+        s->goalDistance = pc->goalDistance;
+        s->pushDirection = pc->pushDirection;
+        s++;
+    }
+}
+
+void FlightRecorder::start() {
+    pushers = cmp::getFactory(pusherProto)->getClones();
+    capacity = settings.enabled ? std::max<size_t>(1, std::lround(settings.seconds / atta::Config::getDt())) : 0;
+    frames.assign(capacity, FrameHeader{});
+    samples.assign(capacity * pushers.size(), RobotSample{});
+    head = 0;
+    numFrames = 0;
+
+    atta::vec3 objPos = object.get<cmp::Transform>()->position;
+    anchorTime = atta::Config::getTime();
+    anchorX = objPos.x;
+    anchorY = objPos.y;
+    stallTriggered = stallReported = false;
+}
+
+void FlightRecorder::record() {
+    if (capacity == 0)
+        return;
+
+    FrameHeader& frame = frames[head];
+    capture(pushers, frame, &samples[head * pushers.size()]);
+    head = (head + 1) % capacity;
+    numFrames = std::min(numFrames + 1, capacity);
+
+    // Stall trigger
+    float dx = frame.objectX - anchorX;
+    float dy = frame.objectY - anchorY;
+    if (dx * dx + dy * dy > settings.stallDistance * settings.stallDistance) {
+        anchorTime = frame.time;
+        anchorX = frame.objectX;
+        anchorY = frame.objectY;
+    } else if (settings.dumpOnStall && frame.time - anchorTime >= settings.stallTime)
+        stallTriggered = true;
+}
+
+const char* FlightRecorder::pollTrigger() {
+    if (stallTriggered && !stallReported) {
+        stallReported = true;
+        return "stall";
+    }
+    return nullptr;
+}
+
+size_t FlightRecorder::getNumFrames() { return numFrames; }
+
+bool FlightRecorder::dump(const std::string& file) {
+    std::ofstream out(file, std::ios::binary);
+    if (!out)
+        return false;
+
+    FileHeader header;
+    header.numRobots = pushers.size();
+    header.numFrames = numFrames;
+    header.dt = atta::Config::getDt();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Oldest frame first
+    size_t first = (head + capacity - numFrames) % std::max<size_t>(capacity, 1);
+    for (size_t i = 0; i < numFrames; i++) {
+        size_t f = (first + i) % capacity;
+        out.write(reinterpret_cast<const char*>(&frames[f]), sizeof(FrameHeader));
+        out.write(reinterpret_cast<const char*>(&samples[f * pushers.size()]), pushers.size() * sizeof(RobotSample));
+    }
+    return bool(out);
+}
@@ -0,0 +1,77 @@
+//--------------------------------------------------
+// Box Pushing
+// flightRecorder.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+#include <atta/component/interface.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keeps the last seconds of the simulation (object pose, pusher poses, states and vision outputs) in memory and dumps
+// them to a binary file when a repetition fails or a trigger condition is met
+namespace FlightRecorder {
+
+//---------- File format ----------//
+// FileHeader followed by numFrames frames, oldest first. Each frame is a FrameHeader followed by numRobots RobotSamples
+struct FileHeader {
+    char magic[4] = {'B', 'P', 'F', 'R'};
+    uint32_t version = 3; // 2: 32 bit flags (with the task), 3: one byte per flag, task in bits 24-31
+    uint32_t numRobots = 0;
+    uint32_t numFrames = 0;
+    float dt = 0.0f; // Simulation time step
+};
+
+struct FrameHeader {
+    float time;
+    float objectX;
+    float objectY;
+    float objectAngle;
+};
+
+struct RobotSample {
+    float x;
+    float y;
+    float angle;
+    uint32_t flags; // PusherComponent::Flag and task
+    uint16_t entity;
+    uint8_t state; // PusherComponent::State
+    uint8_t reserved;
+    float objectDirection;
+    float objectDistance;
+    float goalDirection;
+    float goalDistance;
+    float pushDirection;
+};
+static_assert(sizeof(RobotSample) == 40);
+
+//---------- Recording ----------//
+struct Settings {
+    bool enabled = true;
+    float seconds = 10.0f;    // Recorded window
+    bool dumpOnStall = false; // Trigger when the object does not move for stallTime seconds
+    float stallTime = 30.0f;
+    float stallDistance = 0.05f;
+};
+Settings& getSettings();
+
+// Fill a frame with the current object pose and the state of the given pushers (one sample per pusher)
+void capture(const std::vector<atta::component::Entity>& pushers, FrameHeader& frame, RobotSample* samples);
+
+// Allocates the buffer for the current pushers. Should be called when the simulation starts
+void start();
+// Records the current step. Should be called once per simulation step
+void record();
+
+// Returns the reason of the first trigger since start, or nullptr if nothing triggered yet. Each trigger is reported once
+const char* pollTrigger();
+
+size_t getNumFrames();
+bool dump(const std::string& file);
+
+} // namespace FlightRecorder
+
+#endif // FLIGHT_RECORDER_H
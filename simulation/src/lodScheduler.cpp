@@ -0,0 +1,106 @@
+//--------------------------------------------------
+// Box Pushing
+// lodScheduler.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "lodScheduler.h"
+#include "allocCounter.h"
+#include "chunkedStore.h"
+#include "pusherSensorsComponent.h"
+#include <algorithm>
+#include <atta/component/components/cameraSensor.h>
+#include <atta/component/interface.h>
+
+namespace Lod {
+
+struct Robot {
+    Level level = FULL;
+    uint8_t wait = 0;          // Ticks to wait before the next update
+    uint16_t blindUpdates = 0; // Updates since the object/goal was last seen
+    float baseFps = 0.0f;      // Camera rate at full level
+    Report report;
+};
+
+Settings settings;
+ChunkedStore<Robot> robots(AllocCounter::getResource(AllocCounter::CONTROL));
+
+void setLevel(Robot& r, Level level, CameraRates rates) {
+    if (r.level == level)
+        return;
+    r.wait = level < r.level ? 0 : levelPeriod[level] - 1; // Promotions take effect immediately
+    r.level = level;
+
+    // Capture frames only as often as they are processed
+    if (r.baseFps == 0.0f)
+        r.baseFps = *rates[0];
+    for (float* fps : rates)
+        *fps = r.baseFps / levelPeriod[level];
+}
+
+} // namespace Lod
+
+Lod::Settings& Lod::getSettings() { return settings; }
+
+bool Lod::schedule(cmp::Entity entity, const std::array<float, 8>& irs, CameraRates rates) {
+    Robot& r = robots[entity.getId()];
+    r.report.ticks++;
+
+    // Promote on contact
+    bool contact = *std::min_element(irs.begin(), irs.end()) < settings.contactDist;
+    if (contact)
+        setLevel(r, FULL, rates);
+    r.report.levelTicks[r.level]++;
+
+    if (r.wait == 0) {
+        r.wait = levelPeriod[r.level] - 1;
+        return true;
+    }
+    r.wait--;
+    r.report.throttledTicks++;
+    return false;
+}
+
+void Lod::update(cmp::Entity entity, PusherComponent* pusher, CameraRates rates) {
+    Robot& r = robots[entity.getId()];
+    bool sighting = pusher->canSeeObject() || pusher->canSeeGoal();
+    r.blindUpdates = sighting ? 0 : std::min<uint16_t>(r.blindUpdates + 1, UINT16_MAX);
+
+    Level level = FULL;
+    if (pusher->state == PusherComponent::BE_A_GOAL && !pusher->canSeeObject())
+        level = IDLE; // Standing still until the goal or the object shows up
+    else if (pusher->state == PusherComponent::RANDOM_WALK && r.blindUpdates >= settings.blindUpdates)
+        level = REDUCED;
+    if (sighting && pusher->state != PusherComponent::BE_A_GOAL)
+        level = FULL;
+    setLevel(r, level, rates);
+}
+
+Lod::Report Lod::getReport() {
+    Report total;
+    for (cmp::Entity pusher : cmp::getFactory(pusherProto)->getClones()) {
+        const Report& r = robots[pusher.getId()].report;
+        total.ticks += r.ticks;
+        total.throttledTicks += r.throttledTicks;
+        for (unsigned i = 0; i < NUM_LEVELS; i++)
+            total.levelTicks[i] += r.levelTicks[i];
+    }
+    return total;
+}
+
+Lod::Report Lod::getReport(cmp::Entity entity) { return robots[entity.getId()].report; }
+
+void Lod::reset() {
+    for (cmp::Entity pusher : cmp::getFactory(pusherProto)->getClones()) {
+        Robot& r = robots[pusher.getId()];
+        if (r.baseFps != 0.0f) {
+            if (PusherSensorsComponent* sensors = pusher.get<PusherSensorsComponent>())
+                sensors->fps = r.baseFps;
+            else {
+                cmp::Entity cams = pusher.getChild(0);
+                for (int i = 0; i < 4; i++)
+                    cams.getChild(i).get<cmp::CameraSensor>()->fps = r.baseFps;
+            }
+        }
+        r = Robot{};
+    }
+}
@@ -0,0 +1,55 @@
+//--------------------------------------------------
+// Box Pushing
+// lodScheduler.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef LOD_SCHEDULER_H
+#define LOD_SCHEDULER_H
+#include "common.h"
+#include "pusherComponent.h"
+#include <array>
+#include <cstdint>
+
+// Control-rate level of detail. Pushers that are waiting as goals or wandering without seeing anything run perception and
+// control at a lower rate (re-applying their last command in between), and are promoted back to full rate on infrared
+// contact or when the object/goal is seen
+namespace Lod {
+
+enum Level : uint8_t {
+    FULL = 0,
+    REDUCED,
+    IDLE,
+    NUM_LEVELS,
+};
+inline const std::array<const char*, NUM_LEVELS> levelNames = {"full", "reduced", "idle"};
+inline constexpr std::array<unsigned, NUM_LEVELS> levelPeriod = {1, 2, 4}; // Control ticks per update
+
+struct Settings {
+    bool enabled = false;
+    float contactDist = 0.1f;  // Infrared measurement considered contact
+    unsigned blindUpdates = 20; // Updates without seeing the object/goal before wandering pushers are throttled
+};
+Settings& getSettings();
+
+// Capture rate of each camera (the four point to the same rate for lightweight pushers)
+using CameraRates = std::array<float*, 4>;
+
+// Called every control tick before perception. Returns false if the pusher is throttled in this tick
+bool schedule(cmp::Entity entity, const std::array<float, 8>& irs, CameraRates rates);
+// Called after perception and control to choose the pusher level
+void update(cmp::Entity entity, PusherComponent* pusher, CameraRates rates);
+
+struct Report {
+    uint64_t ticks = 0;
+    uint64_t throttledTicks = 0;
+    std::array<uint64_t, NUM_LEVELS> levelTicks = {}; // Ticks spent in each level
+};
+Report getReport();
+Report getReport(cmp::Entity entity);
+
+// Restores the camera rates of all pushers and clears the counters
+void reset();
+
+} // namespace Lod
+
+#endif // LOD_SCHEDULER_H
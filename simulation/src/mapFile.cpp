@@ -0,0 +1,83 @@
+//--------------------------------------------------
+// Box Pushing
+// mapFile.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "mapFile.h"
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+bool MapFile::load(const std::string& file, MapInfo& map) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        return false;
+    }
+    const size_t size = st.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    const FileHeader* header = static_cast<const FileHeader*>(data);
+    bool valid = std::memcmp(header->magic, FileHeader{}.magic, sizeof(header->magic)) == 0 && header->version == 1 &&
+                 size >= sizeof(FileHeader) + size_t(header->numWalls) * sizeof(WallRecord);
+    if (valid) {
+        map.arenaSize = {header->arenaWidth, header->arenaHeight};
+        map.goalPos = {header->goalX, header->goalY};
+        map.objectPos = {header->objectX, header->objectY};
+        const WallRecord* walls = reinterpret_cast<const WallRecord*>(header + 1);
+        map.walls.resize(header->numWalls);
+        for (uint32_t i = 0; i < header->numWalls; i++)
+            map.walls[i] = {.pos = {walls[i].x, walls[i].y}, .size = {walls[i].width, walls[i].height}, .angle = walls[i].angle};
+    }
+    munmap(data, size);
+    return valid;
+}
+
+bool MapFile::save(const std::string& file, const MapInfo& map) {
+    std::ofstream out(file, std::ios::binary);
+    if (!out)
+        return false;
+
+    FileHeader header;
+    header.arenaWidth = map.arenaSize.x;
+    header.arenaHeight = map.arenaSize.y;
+    header.goalX = map.goalPos.x;
+    header.goalY = map.goalPos.y;
+    header.objectX = map.objectPos.x;
+    header.objectY = map.objectPos.y;
+    header.numWalls = map.walls.size();
+    std::vector<WallRecord> walls;
+    walls.reserve(map.walls.size());
+    for (const WallInfo& w : map.walls)
+        walls.push_back({w.pos.x, w.pos.y, w.size.x, w.size.y, w.angle});
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(walls.data()), walls.size() * sizeof(WallRecord));
+    return bool(out);
+}
+
+std::map<std::string, MapInfo> MapFile::loadDirectory(const std::string& directory, std::vector<std::string>& invalidFiles) {
+    std::map<std::string, MapInfo> maps;
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != extension)
+            continue;
+        MapInfo map;
+        if (load(entry.path().string(), map))
+            maps[entry.path().stem().string()] = map;
+        else
+            invalidFiles.push_back(entry.path().string());
+    }
+    return maps;
+}
@@ -0,0 +1,51 @@
+//--------------------------------------------------
+// Box Pushing
+// mapFile.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+#include "mapInfo.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Binary map files (.bpmap). A fixed size header followed by an array of fixed size wall records, all 4-byte fields in
+// native (little-endian) order, so the file can be mapped into memory and read without parsing
+namespace MapFile {
+
+struct FileHeader {
+    char magic[4] = {'B', 'P', 'M', 'P'};
+    uint32_t version = 1;
+    float arenaWidth = 0.0f;
+    float arenaHeight = 0.0f;
+    float goalX = 0.0f;
+    float goalY = 0.0f;
+    float objectX = 0.0f;
+    float objectY = 0.0f;
+    uint32_t numWalls = 0; // Followed by numWalls WallRecord
+    uint32_t reserved = 0;
+};
+
+struct WallRecord {
+    float x;
+    float y;
+    float width;
+    float height;
+    float angle;
+};
+
+static_assert(sizeof(FileHeader) == 40 && sizeof(WallRecord) == 20, "Map file layout changed");
+
+inline const char* extension = ".bpmap";
+
+bool load(const std::string& file, MapInfo& map);
+bool save(const std::string& file, const MapInfo& map);
+// Load all map files in a directory, indexed by file name without extension. Files that could not be loaded are added to
+// invalidFiles
+std::map<std::string, MapInfo> loadDirectory(const std::string& directory, std::vector<std::string>& invalidFiles);
+
+} // namespace MapFile
+
+#endif // MAP_FILE_H
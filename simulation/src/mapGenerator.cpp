@@ -0,0 +1,87 @@
+//--------------------------------------------------
+// Box Pushing
+// mapGenerator.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "mapGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace MapGenerator {
+
+// Distance between two axis aligned rectangles (zero if they overlap)
+float distance(const WallInfo& a, const WallInfo& b) {
+    float dx = std::max(0.0f, std::abs(a.pos.x - b.pos.x) - (a.size.x + b.size.x) * 0.5f);
+    float dy = std::max(0.0f, std::abs(a.pos.y - b.pos.y) - (a.size.y + b.size.y) * 0.5f);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+float distance(const WallInfo& wall, atta::vec2 p) {
+    float dx = std::max(0.0f, std::abs(wall.pos.x - p.x) - wall.size.x * 0.5f);
+    float dy = std::max(0.0f, std::abs(wall.pos.y - p.y) - wall.size.y * 0.5f);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace MapGenerator
+
+MapInfo MapGenerator::generate(const Params& params) {
+    // Own generator so the global rand() sequence of the runs is not affected
+    std::mt19937 rng(params.seed);
+    auto uniform = [&](float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng); };
+
+    MapInfo map;
+    const float half = params.arenaSize * 0.5f;
+    map.arenaSize = {params.arenaSize, params.arenaSize};
+
+    // Object and goal far apart, away from the border
+    const float margin = std::min(params.goalClearance, half * 0.5f);
+    const float minGoalDist = std::min(params.minGoalDistance, 1.0f) * params.arenaSize;
+    map.objectPos = {uniform(-half + margin, half - margin), uniform(-half + margin, half - margin)};
+    for (int i = 0; i < 1000; i++) {
+        map.goalPos = {uniform(-half + margin, half - margin), uniform(-half + margin, half - margin)};
+        if ((map.goalPos - map.objectPos).length() >= minGoalDist)
+            break;
+    }
+
+    // Walls
+    const float arenaArea = params.arenaSize * params.arenaSize;
+    const float maxLength = std::min(params.maxWallLength, params.arenaSize - 2.0f * params.corridorWidth);
+    const float minLength = std::min(params.minWallLength, maxLength);
+    float wallArea = 0.0f;
+    for (int tries = 0; tries < 100 * int(params.maxWalls) && map.walls.size() < params.maxWalls; tries++) {
+        if (wallArea >= params.wallDensity * arenaArea || maxLength <= 0.0f)
+            break;
+        WallInfo wall;
+        float length = uniform(minLength, maxLength);
+        if (params.tiledWalls) // Whole number of tiles
+            length = std::max(1.0f, std::round(length / params.wallThickness)) * params.wallThickness;
+        wall.size = rng() % 2 ? atta::vec2(length, params.wallThickness) : atta::vec2(params.wallThickness, length);
+        // Keep a corridor between the wall and the border
+        atta::vec2 range = atta::vec2(half - params.corridorWidth) - wall.size * 0.5f;
+        if (range.x <= 0.0f || range.y <= 0.0f)
+            continue;
+        wall.pos = {uniform(-range.x, range.x), uniform(-range.y, range.y)};
+
+        if (distance(wall, map.objectPos) < params.goalClearance || distance(wall, map.goalPos) < params.goalClearance)
+            continue;
+        if (std::any_of(map.walls.begin(), map.walls.end(), [&](const WallInfo& w) { return distance(w, wall) < params.corridorWidth; }))
+            continue;
+        wallArea += wall.size.x * wall.size.y;
+        if (!params.tiledWalls) {
+            map.walls.push_back(wall);
+            continue;
+        }
+
+        // Square tiles along the wall
+        const bool alongX = wall.size.x > wall.size.y;
+        const float side = params.wallThickness;
+        const float start = alongX ? wall.pos.x - wall.size.x * 0.5f : wall.pos.y - wall.size.y * 0.5f;
+        const int numTiles = std::lround(length / side);
+        for (int i = 0; i < numTiles; i++) {
+            const float center = start + (i + 0.5f) * side;
+            map.walls.push_back({alongX ? atta::vec2(center, wall.pos.y) : atta::vec2(wall.pos.x, center), atta::vec2(side, side)});
+        }
+    }
+    return map;
+}
@@ -0,0 +1,34 @@
+//--------------------------------------------------
+// Box Pushing
+// mapGenerator.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+#include "mapInfo.h"
+#include <cstdint>
+
+// Seeded procedural maps for scalability tests on arenas much larger than the paper maps. Walls are axis aligned and kept
+// at least corridorWidth apart from each other and from the arena border, so the free space stays connected and any object
+// narrower than the corridor can reach the goal
+namespace MapGenerator {
+
+struct Params {
+    uint32_t seed = 0;
+    float arenaSize = 30.0f;      // Square arena side (m)
+    float wallDensity = 0.1f;     // Fraction of the arena area covered by walls
+    uint32_t maxWalls = 200;      // Generation stops at the density or at the number of walls
+    float corridorWidth = 1.0f;   // Minimum free space between walls (m)
+    float wallThickness = 0.3f;   // (m)
+    float minWallLength = 1.0f;   // (m)
+    float maxWallLength = 5.0f;   // (m)
+    float goalClearance = 1.0f;   // Free radius around the object start and the goal (m)
+    float minGoalDistance = 0.5f; // Minimum object-goal distance as a fraction of the arena side
+    bool tiledWalls = false;      // Build each wall from touching square tiles of wallThickness side, as maps drawn on a grid
+};
+
+MapInfo generate(const Params& params);
+
+} // namespace MapGenerator
+
+#endif // MAP_GENERATOR_H
@@ -0,0 +1,160 @@
+//--------------------------------------------------
+// Box Pushing
+// mapInfo.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "mapInfo.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+
+constexpr float eps = 1e-4f;
+
+// Wall as a segment of a line: direction of the long side, offset of the line and interval along it
+struct Segment {
+    size_t wall;
+    bool alongX;     // If the line follows the wall x axis
+    float lineAngle; // [0, pi)
+    float offset;    // Signed distance from the origin to the line
+    float thickness;
+    float min;
+    float max;
+    std::array<int64_t, 3> line; // Quantized angle, offset and thickness, equal for walls on the same line
+};
+
+bool isSquare(const WallInfo& wall) { return std::abs(wall.size.x - wall.size.y) < eps; }
+
+Segment toSegment(const WallInfo& wall, size_t idx, bool alongX) {
+    Segment s;
+    s.wall = idx;
+    s.alongX = alongX;
+    float angle = wall.angle + (alongX ? 0.0f : M_PI_2);
+    angle = std::fmod(angle, float(M_PI));
+    if (angle < 0.0f)
+        angle += M_PI;
+    if (angle > M_PI - eps) // Snap so both ends of the range compare equal
+        angle = 0.0f;
+    s.lineAngle = angle;
+    const atta::vec2 d(std::cos(angle), std::sin(angle));
+    const float length = alongX ? wall.size.x : wall.size.y;
+    const float t = d.x * wall.pos.x + d.y * wall.pos.y;
+    s.offset = d.x * wall.pos.y - d.y * wall.pos.x;
+    s.thickness = alongX ? wall.size.y : wall.size.x;
+    s.min = t - length * 0.5f;
+    s.max = t + length * 0.5f;
+    s.line = {std::llround(s.lineAngle / eps), std::llround(s.offset / eps), std::llround(s.thickness / eps)};
+    return s;
+}
+
+// Walls indexed by the grid cells their bounding boxes overlap, so the walls touching a wall are found without scanning the map
+class WallGrid {
+  public:
+    WallGrid(const std::vector<WallInfo>& walls) : _walls(walls) {
+        // Cells about the size of the typical wall, long walls are added to every cell they overlap
+        float sum = 0.0f;
+        for (const WallInfo& wall : walls)
+            sum += std::max(wall.size.x, wall.size.y);
+        _cellSize = walls.empty() ? 1.0f : std::max(sum / walls.size(), 10 * eps);
+        for (size_t i = 0; i < walls.size(); i++)
+            forEachCell(walls[i], [&](uint64_t cell) { _cells[cell].push_back(i); });
+    }
+
+    // Calls f(i) for the walls in the cells overlapped by the wall (a wall can be visited more than once)
+    template <typename F>
+    void forEachNearby(const WallInfo& wall, F f) const {
+        forEachCell(wall, [&](uint64_t cell) {
+            auto it = _cells.find(cell);
+            if (it != _cells.end())
+                for (size_t i : it->second)
+                    f(i);
+        });
+    }
+
+    const std::vector<WallInfo>& walls() const { return _walls; }
+
+  private:
+    template <typename F>
+    void forEachCell(const WallInfo& wall, F f) const {
+        atta::vec2 lo = wall.pos;
+        atta::vec2 hi = wall.pos;
+        for (atta::vec2 c : getCorners(wall)) {
+            lo = atta::vec2(std::min(lo.x, c.x), std::min(lo.y, c.y));
+            hi = atta::vec2(std::max(hi.x, c.x), std::max(hi.y, c.y));
+        }
+        const int64_t x0 = std::floor((lo.x - eps) / _cellSize), x1 = std::floor((hi.x + eps) / _cellSize);
+        const int64_t y0 = std::floor((lo.y - eps) / _cellSize), y1 = std::floor((hi.y + eps) / _cellSize);
+        for (int64_t x = x0; x <= x1; x++)
+            for (int64_t y = y0; y <= y1; y++)
+                f((uint64_t(uint32_t(x)) << 32) | uint32_t(y));
+    }
+
+    const std::vector<WallInfo>& _walls;
+    float _cellSize;
+    std::unordered_map<uint64_t, std::vector<size_t>> _cells;
+};
+
+// If the segment touches or overlaps another wall on the same line (square walls lie on a line along each axis)
+bool hasNeighbor(const WallGrid& grid, const Segment& s) {
+    const std::vector<WallInfo>& walls = grid.walls();
+    bool found = false;
+    grid.forEachNearby(walls[s.wall], [&](size_t i) {
+        if (found || i == s.wall)
+            return;
+        for (bool alongX : {true, false}) {
+            if (!isSquare(walls[i]) && alongX != (walls[i].size.x > walls[i].size.y))
+                continue;
+            const Segment o = toSegment(walls[i], i, alongX);
+            if (o.line == s.line && o.min <= s.max + eps && s.min <= o.max + eps)
+                found = true;
+        }
+    });
+    return found;
+}
+
+// Segment of the long side. Square walls have no long side, they are merged along the y axis when they only have neighbors
+// in that direction (e.g. vertical runs of square tiles)
+Segment wallSegment(const WallGrid& grid, size_t idx) {
+    const WallInfo& wall = grid.walls()[idx];
+    if (!isSquare(wall))
+        return toSegment(wall, idx, wall.size.x > wall.size.y);
+    const Segment x = toSegment(wall, idx, true);
+    const Segment y = toSegment(wall, idx, false);
+    return !hasNeighbor(grid, x) && hasNeighbor(grid, y) ? y : x;
+}
+
+} // namespace
+
+std::vector<WallInfo> mergeColinearWalls(const std::vector<WallInfo>& walls) {
+    const WallGrid grid(walls);
+    std::vector<Segment> segments;
+    segments.reserve(walls.size());
+    for (size_t i = 0; i < walls.size(); i++)
+        segments.push_back(wallSegment(grid, i));
+
+    // Group by line, then by position along it
+    std::sort(segments.begin(), segments.end(),
+              [](const Segment& a, const Segment& b) { return a.line != b.line ? a.line < b.line : a.min < b.min; });
+
+    std::vector<WallInfo> merged;
+    for (size_t i = 0; i < segments.size();) {
+        const Segment first = segments[i];
+        Segment run = first;
+        size_t j = i + 1;
+        while (j < segments.size() && run.line == segments[j].line && segments[j].min <= run.max + eps)
+            run.max = std::max(run.max, segments[j++].max);
+
+        // Keep the first wall orientation, move its center to the middle of the run
+        WallInfo wall = walls[run.wall];
+        const atta::vec2 d(std::cos(first.lineAngle), std::sin(first.lineAngle));
+        wall.pos += d * ((run.min + run.max) * 0.5f - (first.min + first.max) * 0.5f);
+        if (run.alongX)
+            wall.size.x = run.max - run.min;
+        else
+            wall.size.y = run.max - run.min;
+        merged.push_back(wall);
+        i = j;
+    }
+    return merged;
+}
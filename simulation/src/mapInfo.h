@@ -0,0 +1,42 @@
+//--------------------------------------------------
+// Box Pushing
+// mapInfo.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef MAP_INFO_H
+#define MAP_INFO_H
+#include <array>
+#include <atta/utils/math/vector.h>
+#include <cmath>
+#include <vector>
+
+struct WallInfo {
+    atta::vec2 pos;
+    atta::vec2 size;
+    float angle = 0.0f; // Rotation around the center (rad)
+};
+
+// Wall rectangle corners in counter-clockwise order
+inline std::array<atta::vec2, 4> getCorners(const WallInfo& wall) {
+    const atta::vec2 half = wall.size * 0.5f;
+    const float c = std::cos(wall.angle);
+    const float s = std::sin(wall.angle);
+    std::array<atta::vec2, 4> corners = {atta::vec2(half.x, -half.y), atta::vec2(half.x, half.y), atta::vec2(-half.x, half.y),
+                                         atta::vec2(-half.x, -half.y)};
+    for (atta::vec2& p : corners)
+        p = wall.pos + atta::vec2(c * p.x - s * p.y, s * p.x + c * p.y);
+    return corners;
+}
+
+struct MapInfo {
+    atta::vec2 goalPos;
+    atta::vec2 objectPos;
+    std::vector<WallInfo> walls;
+    atta::vec2 arenaSize = {3.0f, 3.0f}; // Arena centered at the origin
+};
+
+// Merge walls of the same thickness that lie on the same line and touch or overlap, so each run of wall segments becomes a
+// single static body. Square walls (tiles) are merged along either axis. The union of the merged walls is unchanged
+std::vector<WallInfo> mergeColinearWalls(const std::vector<WallInfo>& walls);
+
+#endif // MAP_INFO_H
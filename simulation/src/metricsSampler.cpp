@@ -0,0 +1,113 @@
+//--------------------------------------------------
+// Box Pushing
+// metricsSampler.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "metricsSampler.h"
+#include "common.h"
+#include "pusherComponent.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <atta/component/components/transform.h>
+#include <atta/utils/config.h>
+#include <vector>
+
+namespace MetricsSampler {
+
+Settings settings;
+
+std::vector<cmp::Entity> pushers;
+std::vector<uint8_t> lastStates; // State of each pusher in the previous step
+std::array<std::vector<float>, NUM_COLUMNS> columns;
+size_t capacity = 0; // Samples
+size_t head = 0;     // Next sample to write
+size_t numSamples = 0;
+size_t numDropped = 0;
+uint64_t wallTime = 0; // ns
+
+// Current interval
+int numSteps = 0;
+std::array<uint32_t, PusherComponent::stateNames.size()> stateSteps = {}; // Pusher steps in each state
+uint32_t transitions = 0;
+uint32_t pushAroundSwitches = 0;
+float intervalStartTime = 0.0f;
+atta::vec2 intervalStartPos = atta::vec2(0.0f);
+
+} // namespace MetricsSampler
+
+MetricsSampler::Settings& MetricsSampler::getSettings() { return settings; }
+
+void MetricsSampler::start() {
+    pushers = cmp::getFactory(pusherProto)->getClones();
+    lastStates.resize(pushers.size());
+    for (size_t i = 0; i < pushers.size(); i++)
+        lastStates[i] = pushers[i].get<PusherComponent>()->state;
+    capacity = settings.enabled ? std::max<size_t>(1, settings.maxSamples) : 0;
+    for (std::vector<float>& column : columns)
+        column.assign(capacity, 0.0f);
+    head = 0;
+    numSamples = 0;
+    numDropped = 0;
+    wallTime = 0;
+
+    numSteps = 0;
+    stateSteps = {};
+    transitions = pushAroundSwitches = 0;
+    intervalStartTime = atta::Config::getTime();
+    intervalStartPos = atta::vec2(object.get<cmp::Transform>()->position);
+}
+
+void MetricsSampler::sample() {
+    if (capacity == 0)
+        return;
+    uint64_t begin = Telemetry::now();
+
+    // Accumulate the step
+    for (size_t i = 0; i < pushers.size(); i++) {
+        uint8_t state = pushers[i].get<PusherComponent>()->state;
+        uint8_t last = lastStates[i];
+        stateSteps[state]++;
+        if (state != last) {
+            transitions++;
+            pushAroundSwitches += (state == PusherComponent::PUSH_OBJECT && last == PusherComponent::MOVE_AROUND_OBJECT) ||
+                                  (state == PusherComponent::MOVE_AROUND_OBJECT && last == PusherComponent::PUSH_OBJECT);
+            lastStates[i] = state;
+        }
+    }
+
+    // Store the interval
+    if (++numSteps >= std::max(1, settings.decimation)) {
+        const float time = atta::Config::getTime();
+        const atta::vec2 objPos = atta::vec2(object.get<cmp::Transform>()->position);
+        const atta::vec2 goalPos = atta::vec2(goal.get<cmp::Transform>()->position);
+        columns[TIME][head] = time;
+        for (size_t s = 0; s < stateSteps.size(); s++)
+            columns[RANDOM_WALK + s][head] = stateSteps[s] / float(numSteps);
+        columns[TRANSITIONS][head] = transitions;
+        columns[PUSH_AROUND_SWITCHES][head] = pushAroundSwitches;
+        columns[OBJECT_SPEED][head] = time > intervalStartTime ? (objPos - intervalStartPos).length() / (time - intervalStartTime) : 0.0f;
+        columns[OBJECT_GOAL_DISTANCE][head] = (objPos - goalPos).length();
+        head = (head + 1) % capacity;
+        numDropped += numSamples == capacity;
+        numSamples = std::min(numSamples + 1, capacity);
+
+        numSteps = 0;
+        stateSteps = {};
+        transitions = pushAroundSwitches = 0;
+        intervalStartTime = time;
+        intervalStartPos = objPos;
+    }
+
+    wallTime += Telemetry::now() - begin;
+}
+
+size_t MetricsSampler::getNumSamples() { return numSamples; }
+
+size_t MetricsSampler::getNumDropped() { return numDropped; }
+
+float MetricsSampler::getValue(Column column, size_t i) {
+    size_t first = (head + capacity - numSamples) % std::max<size_t>(capacity, 1);
+    return columns[column][(first + i) % capacity];
+}
+
+double MetricsSampler::getWallTime() { return wallTime * 1e-9; }
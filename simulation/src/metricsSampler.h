@@ -0,0 +1,54 @@
+//--------------------------------------------------
+// Box Pushing
+// metricsSampler.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef METRICS_SAMPLER_H
+#define METRICS_SAMPLER_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Time series of swarm metrics (pushers per state, state transitions, object motion). Every step is accumulated, and one
+// sample with the interval averages is stored every `decimation` steps in preallocated columns (ring buffer, the oldest
+// samples are overwritten when the run is longer than `maxSamples`)
+namespace MetricsSampler {
+
+enum Column : uint32_t {
+    TIME = 0, // Simulation time at the end of the interval (s)
+    // Mean number of pushers in each PusherComponent::State over the interval (BE_A_GOAL are the sub-goal pushers)
+    RANDOM_WALK,
+    APPROACH_OBJECT,
+    MOVE_AROUND_OBJECT,
+    PUSH_OBJECT,
+    BE_A_GOAL,
+    TRANSITIONS,          // State changes in the interval
+    PUSH_AROUND_SWITCHES, // Changes between PUSH_OBJECT and MOVE_AROUND_OBJECT in the interval
+    OBJECT_SPEED,         // Object displacement over the interval duration (m/s)
+    OBJECT_GOAL_DISTANCE, // At the end of the interval (m)
+    NUM_COLUMNS,
+};
+inline const std::array<const char*, NUM_COLUMNS> columnNames = {"time",        "randomWalk",  "approachObject",     "moveAroundObject",
+                                                                 "pushObject",  "beAGoal",     "transitions",        "pushAroundSwitches",
+                                                                 "objectSpeed", "objectGoalDistance"};
+
+struct Settings {
+    bool enabled = true;
+    int decimation = 10;      // Steps per sample
+    size_t maxSamples = 8192; // Ring buffer capacity
+};
+Settings& getSettings();
+
+// Allocates the columns for the current pushers. Should be called when the simulation starts
+void start();
+// Accumulates the current step. Should be called once per simulation step
+void sample();
+
+size_t getNumSamples();
+size_t getNumDropped();                  // Samples overwritten by the ring buffer
+float getValue(Column column, size_t i); // Sample i, oldest first
+double getWallTime();                    // Seconds spent sampling since start
+
+} // namespace MetricsSampler
+
+#endif // METRICS_SAMPLER_H
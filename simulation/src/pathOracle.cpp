@@ -0,0 +1,263 @@
+//--------------------------------------------------
+// Box Pushing
+// pathOracle.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "pathOracle.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+
+namespace PathOracle {
+
+using Polygon = std::vector<atta::vec2>; // Convex, counter-clockwise
+
+constexpr int cornerVertices = 2; // Vertices approximating each rounded corner
+constexpr float eps = 1e-4f;
+
+// Polygon that contains the wall inflated by radius (rectangle with rounded corners), so paths around it are valid
+Polygon inflateWall(const WallInfo& wall, float radius) {
+    Polygon polygon;
+    const std::array<atta::vec2, 4> corners = getCorners(wall);
+    const float step = M_PI_2 / cornerVertices;
+    const float r = radius / std::cos(step * 0.5f); // Circumscribe the corner arc
+    for (int c = 0; c < 4; c++) {
+        const float start = wall.angle - M_PI_2 + c * M_PI_2; // Arc of corner c goes from start to start + pi/2
+        for (int i = 0; i < cornerVertices; i++) {
+            float a = start + (i + 0.5f) * step;
+            polygon.push_back(corners[c] + atta::vec2(std::cos(a), std::sin(a)) * r);
+        }
+    }
+    return polygon;
+}
+
+float cross(atta::vec2 a, atta::vec2 b) { return a.x * b.y - a.y * b.x; }
+
+bool isInside(const Polygon& polygon, atta::vec2 p) {
+    for (size_t i = 0; i < polygon.size(); i++) {
+        atta::vec2 a = polygon[i];
+        atta::vec2 b = polygon[(i + 1) % polygon.size()];
+        if (cross(b - a, p - a) <= eps)
+            return false;
+    }
+    return true;
+}
+
+// Check if the segment passes through the polygon interior (touching the boundary is allowed)
+bool crossesInterior(const Polygon& polygon, atta::vec2 p0, atta::vec2 p1) {
+    // Clip the segment against the polygon half-planes (Cyrus-Beck)
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    const atta::vec2 d = p1 - p0;
+    for (size_t i = 0; i < polygon.size(); i++) {
+        atta::vec2 a = polygon[i];
+        atta::vec2 e = polygon[(i + 1) % polygon.size()] - a;
+        float len = std::sqrt(e.x * e.x + e.y * e.y);
+        // Signed distance to the edge line (positive inside), shrunk by eps
+        float dist0 = cross(e, p0 - a) / len - eps;
+        float dDist = cross(e, d) / len;
+        if (std::abs(dDist) < 1e-9f) {
+            if (dist0 <= 0.0f)
+                return false; // Parallel and outside
+            continue;
+        }
+        float t = -dist0 / dDist;
+        if (dDist > 0.0f)
+            tEnter = std::max(tEnter, t);
+        else
+            tExit = std::min(tExit, t);
+        if (tEnter >= tExit)
+            return false;
+    }
+    return tExit - tEnter > eps;
+}
+
+struct Box {
+    atta::vec2 min;
+    atta::vec2 max;
+};
+
+Box boundingBox(const Polygon& polygon) {
+    Box box{polygon[0], polygon[0]};
+    for (atta::vec2 v : polygon) {
+        box.min = {std::min(box.min.x, v.x), std::min(box.min.y, v.y)};
+        box.max = {std::max(box.max.x, v.x), std::max(box.max.y, v.y)};
+    }
+    return box;
+}
+
+// Uniform grid over the polygon bounding boxes, so visibility queries only test the polygons along the segment. Most of the
+// polygons are far from any segment on large maps
+class Grid {
+  public:
+    Grid(const std::vector<Polygon>& polygons) : _polygons(polygons), _stamps(polygons.size(), 0) {
+        if (polygons.empty())
+            return;
+        std::vector<Box> boxes;
+        Box bounds = boundingBox(polygons[0]);
+        float meanSize = 0.0f;
+        for (const Polygon& polygon : polygons) {
+            boxes.push_back(boundingBox(polygon));
+            bounds.min = {std::min(bounds.min.x, boxes.back().min.x), std::min(bounds.min.y, boxes.back().min.y)};
+            bounds.max = {std::max(bounds.max.x, boxes.back().max.x), std::max(bounds.max.y, boxes.back().max.y)};
+            meanSize += std::max(boxes.back().max.x - boxes.back().min.x, boxes.back().max.y - boxes.back().min.y);
+        }
+        _origin = bounds.min;
+        _cellSize = meanSize / polygons.size();
+        _nx = std::min(1024, int((bounds.max.x - bounds.min.x) / _cellSize) + 1);
+        _ny = std::min(1024, int((bounds.max.y - bounds.min.y) / _cellSize) + 1);
+        _cellSize = std::max((bounds.max.x - bounds.min.x) / _nx, (bounds.max.y - bounds.min.y) / _ny) * (1.0f + eps);
+        _cells.resize(_nx * _ny);
+        for (size_t i = 0; i < boxes.size(); i++)
+            for (int y = cellY(boxes[i].min.y); y <= cellY(boxes[i].max.y); y++)
+                for (int x = cellX(boxes[i].min.x); x <= cellX(boxes[i].max.x); x++)
+                    _cells[y * _nx + x].push_back(i);
+    }
+
+    bool isVisible(atta::vec2 p0, atta::vec2 p1) {
+        if (_cells.empty())
+            return true;
+        _stamp++;
+        // Walk the cells crossed by the segment (clamped to the grid, the polygons are inside it)
+        const atta::vec2 d = p1 - p0;
+        int x = cellX(p0.x), y = cellY(p0.y);
+        const int x1 = cellX(p1.x), y1 = cellY(p1.y);
+        const int stepX = d.x > 0.0f ? 1 : -1, stepY = d.y > 0.0f ? 1 : -1;
+        auto nextT = [&](float p, float dir, int cell, int step, float origin) {
+            if (dir == 0.0f)
+                return std::numeric_limits<float>::infinity();
+            return (origin + (cell + (step > 0 ? 1 : 0)) * _cellSize - p) / dir;
+        };
+        float tx = nextT(p0.x, d.x, x, stepX, _origin.x), ty = nextT(p0.y, d.y, y, stepY, _origin.y);
+        const float dtx = d.x != 0.0f ? _cellSize / std::abs(d.x) : 0.0f, dty = d.y != 0.0f ? _cellSize / std::abs(d.y) : 0.0f;
+        while (true) {
+            for (int i : _cells[y * _nx + x]) {
+                if (_stamps[i] == _stamp)
+                    continue;
+                _stamps[i] = _stamp;
+                if (crossesInterior(_polygons[i], p0, p1))
+                    return false;
+            }
+            if (x == x1 && y == y1)
+                break;
+            if (tx < ty) {
+                if (x == x1)
+                    break;
+                x += stepX;
+                tx += dtx;
+            } else {
+                if (y == y1)
+                    break;
+                y += stepY;
+                ty += dty;
+            }
+        }
+        return true;
+    }
+
+  private:
+    int cellX(float x) const { return std::clamp(int(std::floor((x - _origin.x) / _cellSize)), 0, _nx - 1); }
+    int cellY(float y) const { return std::clamp(int(std::floor((y - _origin.y) / _cellSize)), 0, _ny - 1); }
+
+    const std::vector<Polygon>& _polygons;
+    std::vector<std::vector<int>> _cells;
+    std::vector<uint32_t> _stamps; // Polygons already tested in the current query
+    uint32_t _stamp = 0;
+    atta::vec2 _origin;
+    float _cellSize = 1.0f;
+    int _nx = 0;
+    int _ny = 0;
+};
+
+std::map<std::pair<std::string, std::string>, Result> cache;
+
+} // namespace PathOracle
+
+PathOracle::Result PathOracle::computeOptimalPath(const MapInfo& map, float objectRadius, float minDist) {
+    std::vector<Polygon> polygons;
+    for (const WallInfo& wall : map.walls)
+        polygons.push_back(inflateWall(wall, objectRadius));
+    Grid grid(polygons);
+
+    // The object center must stay inside the arena shrunk by the object radius. The region is convex, so a segment is inside
+    // if its end points are
+    const atta::vec2 bounds = map.arenaSize * 0.5f - atta::vec2(objectRadius, objectRadius);
+    auto inArena = [&](atta::vec2 p) { return std::abs(p.x) <= bounds.x + eps && std::abs(p.y) <= bounds.y + eps; };
+
+    // Nodes: start followed by the polygon vertices that are not inside other polygons
+    std::vector<atta::vec2> nodes = {map.objectPos};
+    for (const Polygon& polygon : polygons)
+        for (atta::vec2 v : polygon)
+            if (inArena(v) && std::none_of(polygons.begin(), polygons.end(), [&](const Polygon& p) { return isInside(p, v); }))
+                nodes.push_back(v);
+
+    // A* over the visibility graph. The goal is reached by a straight line from a node to the goal region, whose length is
+    // the heuristic
+    const size_t n = nodes.size();
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<float> heuristic(n);
+    for (size_t i = 0; i < n; i++)
+        heuristic[i] = std::max(0.0f, (map.goalPos - nodes[i]).length() - minDist);
+    std::vector<float> dist(n, inf);
+    std::vector<int> previous(n, -1);
+    std::vector<bool> visited(n, false);
+    dist[0] = 0.0f;
+    float best = inf;
+    int bestNode = -1;
+    for (size_t iter = 0; iter < n; iter++) {
+        int u = -1;
+        for (size_t i = 0; i < n; i++)
+            if (!visited[i] && dist[i] < inf && (u == -1 || dist[i] + heuristic[i] < dist[u] + heuristic[u]))
+                u = i;
+        if (u == -1 || dist[u] + heuristic[u] >= best)
+            break;
+        visited[u] = true;
+
+        // Finish towards the goal
+        atta::vec2 toGoal = map.goalPos - nodes[u];
+        float goalDist = std::sqrt(toGoal.x * toGoal.x + toGoal.y * toGoal.y);
+        float remaining = std::max(0.0f, goalDist - minDist);
+        atta::vec2 end = goalDist > 0.0f ? nodes[u] + toGoal * (remaining / goalDist) : nodes[u];
+        if (dist[u] + remaining < best && inArena(end) && grid.isVisible(nodes[u], end)) {
+            best = dist[u] + remaining;
+            bestNode = u;
+        }
+
+        for (size_t v = 0; v < n; v++) {
+            if (visited[v])
+                continue;
+            atta::vec2 e = nodes[v] - nodes[u];
+            float d = dist[u] + std::sqrt(e.x * e.x + e.y * e.y);
+            if (d < dist[v] && grid.isVisible(nodes[u], nodes[v])) {
+                dist[v] = d;
+                previous[v] = u;
+            }
+        }
+    }
+
+    Result result;
+    if (bestNode == -1)
+        return result;
+    result.length = best;
+    for (int i = bestNode; i != -1; i = previous[i])
+        result.path.push_back(nodes[i]);
+    std::reverse(result.path.begin(), result.path.end());
+    atta::vec2 toGoal = map.goalPos - result.path.back();
+    float goalDist = std::sqrt(toGoal.x * toGoal.x + toGoal.y * toGoal.y);
+    if (goalDist > minDist)
+        result.path.push_back(result.path.back() + toGoal * ((goalDist - minDist) / goalDist));
+    return result;
+}
+
+const PathOracle::Result& PathOracle::getOptimalPath(const std::string& mapName, const std::string& objectName, const MapInfo& map,
+                                                     float objectRadius, float minDist) {
+    auto key = std::make_pair(mapName, objectName);
+    auto it = cache.find(key);
+    if (it == cache.end())
+        it = cache.emplace(key, computeOptimalPath(map, objectRadius, minDist)).first;
+    return it->second;
+}
+
+void PathOracle::clearCache() { cache.clear(); }
@@ -0,0 +1,30 @@
+//--------------------------------------------------
+// Box Pushing
+// pathOracle.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef PATH_ORACLE_H
+#define PATH_ORACLE_H
+#include "mapInfo.h"
+#include <string>
+#include <vector>
+
+// Shortest object path used as reference for the path efficiency. The walls are inflated by the object footprint radius
+// (configuration space of a disc that contains the object in any orientation) and the path is searched in the visibility
+// graph of the inflated walls inside the arena, from objectPos until the object center is within minDist of goalPos
+namespace PathOracle {
+
+struct Result {
+    float length = NAN; // NAN if the goal can't be reached
+    std::vector<atta::vec2> path;
+};
+
+Result computeOptimalPath(const MapInfo& map, float objectRadius, float minDist);
+// Cached per map and object
+const Result& getOptimalPath(const std::string& mapName, const std::string& objectName, const MapInfo& map, float objectRadius, float minDist);
+// Should be called when maps are reloaded
+void clearCache();
+
+} // namespace PathOracle
+
+#endif // PATH_ORACLE_H
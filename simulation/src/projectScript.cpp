@@ -4,12 +4,32 @@
 // Date: 2022-10-31
 //--------------------------------------------------
 #include "projectScript.h"
+#include "allocCounter.h"
+#include "chainAnalysis.h"
 #include "common.h"
+#include "controllerParams.h"
+#include "experimentStats.h"
+#include "flightRecorder.h"
+#include "lodScheduler.h"
+#include "mapFile.h"
+#include "mapGenerator.h"
+#include "mapInfo.h"
+#include "metricsSampler.h"
+#include "pathOracle.h"
+#include "pusherCommon.h"
 #include "pusherComponent.h"
+#include "pusherSensorsComponent.h"
+#include "replay.h"
+#include "sensorModel.h"
+#include "stateHash.h"
+#include "telemetry.h"
+#include "traceRecorder.h"
 
 #include "imgui.h"
 #include <atta/component/components/boxCollider2D.h>
+#include <atta/component/components/cameraSensor.h>
 #include <atta/component/components/circleCollider2D.h>
+#include <atta/component/components/infraredSensor.h>
 #include <atta/component/components/material.h>
 #include <atta/component/components/mesh.h>
 #include <atta/component/components/name.h>
@@ -22,10 +42,15 @@
 #include <atta/component/components/transform.h>
 #include <atta/event/events/simulationStart.h>
 #include <atta/event/events/simulationStop.h>
+#include <atta/event/events/windowClose.h>
 #include <atta/event/interface.h>
 #include <atta/graphics/drawer.h>
+#include <atta/resource/interface.h>
+#include <atta/resource/resources/material.h>
 #include <atta/sensor/interface.h>
 #include <atta/utils/config.h>
+#include <cstdlib>
+#include <optional>
 
 namespace gfx = atta::graphics;
 namespace cmp = atta::component;
@@ -33,17 +58,7 @@ namespace sns = atta::sensor;
 namespace evt = atta::event;
 
 //---------- Maps ----------//
-struct WallInfo {
-    atta::vec2 pos;
-    atta::vec2 size;
-};
-
-struct MapInfo {
-    atta::vec2 goalPos;
-    atta::vec2 objectPos;
-    std::vector<WallInfo> walls;
-};
-
+// Paper maps, maps from files with the same name replace them
 std::map<std::string, MapInfo> maps = {
     {
         "reference",
@@ -83,6 +98,18 @@ std::map<std::string, MapInfo> maps = {
     },
 };
 
+// Map files are indexed from this directory by file name (maps/<name>.bpmap), experiments reference maps by that name
+const fs::path mapsDirectory = "maps";
+std::map<std::string, std::string> mapFiles; // Map name to file
+
+// Large arenas for scalability tests (the paper maps are 3m x 3m). Generated and saved to the maps directory when their file
+// does not exist, later loads read the file
+const std::map<std::string, MapGenerator::Params> generatedMaps = {
+    {"generated-10m", {.seed = 1, .arenaSize = 10.0f, .wallDensity = 0.08f, .corridorWidth = 1.0f}},
+    {"generated-30m", {.seed = 1, .arenaSize = 30.0f, .wallDensity = 0.08f, .corridorWidth = 1.0f}},
+    {"generated-10m-tiled", {.seed = 1, .arenaSize = 10.0f, .wallDensity = 0.08f, .corridorWidth = 1.0f, .tiledWalls = true}},
+};
+
 //---------- Experiments ----------//
 struct Experiment {
     int numRepetitions = 1;
@@ -92,9 +119,12 @@ struct Experiment {
     std::string object = "circle";
     std::string initialPos = "random";
     std::string script = "PusherScript";
+    int numTasks = 1; // Object/goal pairs
 };
 
 const float gTimeout = 20 * 60.0f; // Global timeout in seconds
+// Stopping rule of the adaptive mode (maxRepetitions is taken from each experiment numRepetitions)
+const ExperimentStats::StoppingRule gStoppingRule = {.minRepetitions = 10, .successRateWidth = 0.2f, .medianTimeWidth = 0.2f};
 // clang-format off
 std::vector<Experiment> experiments = {
     //---------- RANDOM ----------//
@@ -255,68 +285,361 @@ std::vector<Experiment> experiments = {
     {.numRepetitions = 1, .numRobots = 20, .timeout = gTimeout, .map = "middle", .object = "square", .initialPos="random", .script = "PusherTeleopScript"},
     {.numRepetitions = 1, .numRobots = 20, .timeout = gTimeout, .map = "corner", .object = "square", .initialPos="random", .script = "PusherTeleopScript"},
     {.numRepetitions = 1, .numRobots = 20, .timeout = gTimeout, .map = "2-corners", .object = "square", .initialPos = "random", .script = "PusherTeleopScript"},
+
+    //---------- SCALABILITY ----------//
+    // Generated large arenas
+    {.numRepetitions = 1, .numRobots = 50, .timeout = gTimeout, .map = "generated-10m", .object = "square", .initialPos = "random", .script = "PusherScript"},
+    {.numRepetitions = 1, .numRobots = 200, .timeout = gTimeout, .map = "generated-30m", .object = "square", .initialPos = "random", .script = "PusherScript"},
+
+    //---------- THROUGHPUT ----------//
+    // Several objects transported at the same time
+    {.numRepetitions = 1, .numRobots = 40, .timeout = gTimeout, .map = "reference", .object = "circle", .initialPos = "random", .script = "PusherScript", .numTasks = 2},
+    {.numRepetitions = 1, .numRobots = 80, .timeout = gTimeout, .map = "generated-10m", .object = "square", .initialPos = "random", .script = "PusherScript", .numTasks = 4},
 };
 // clang-format on
 
+//---------- Batch jobs ----------//
+// Environment variable with the job file. A job holds the controller parameters, a seed and the experiments to run with one
+// repetition each, e.g. {"params": {...}, "seed": 0, "experiments": [{"map": "corner", "object": "square", "numRobots": 20,
+// "timeout": 600}], "output": "result.json"}. Optionally "lightweightPushers": true runs all experiments with lightweight pushers,
+// and "lod": true with the control-rate level of detail
+const char* batchJobEnv = "BOX_PUSHING_JOB";
+const fs::path controllerParamsFile = "controllerParams.json";
+
+//---------- Tasks ----------//
+// Object/goal pairs, the first one is the scene object and goal
+std::vector<cmp::Entity> taskObjects = {object};
+std::vector<cmp::Entity> taskGoals = {goal};
+
+bool overlapsWalls(const std::vector<WallInfo>& walls, atta::vec2 pos, float radius) {
+    for (const WallInfo& wall : walls) {
+        // Bounding box of the (possibly rotated) wall
+        float halfX = (std::abs(std::cos(wall.angle)) * wall.size.x + std::abs(std::sin(wall.angle)) * wall.size.y) * 0.5f;
+        float halfY = (std::abs(std::sin(wall.angle)) * wall.size.x + std::abs(std::cos(wall.angle)) * wall.size.y) * 0.5f;
+        if (pos.x + radius >= wall.pos.x - halfX && pos.x - radius <= wall.pos.x + halfX && pos.y + radius >= wall.pos.y - halfY &&
+            pos.y - radius <= wall.pos.y + halfY)
+            return true;
+    }
+    return false;
+}
+
+//---------- Lightweight pushers ----------//
+// Camera/infrared subtree of the pusher prototype, kept while it is replaced by the PusherSensorsComponent
+struct SensorEntity {
+    cmp::Transform transform;
+    cmp::Name name;
+    std::optional<cmp::CameraSensor> camera;
+    std::optional<cmp::InfraredSensor> infrared;
+    std::vector<SensorEntity> children;
+};
+std::vector<SensorEntity> pusherSensorEntities;
+
+SensorEntity takeSensorEntity(cmp::Entity entity) {
+    SensorEntity sensor{.transform = *entity.get<cmp::Transform>(), .name = *entity.get<cmp::Name>()};
+    if (cmp::CameraSensor* camera = entity.get<cmp::CameraSensor>())
+        sensor.camera = *camera;
+    if (cmp::InfraredSensor* infrared = entity.get<cmp::InfraredSensor>())
+        sensor.infrared = *infrared;
+    if (cmp::Relationship* r = entity.get<cmp::Relationship>())
+        for (cmp::Entity child : r->getChildren())
+            sensor.children.push_back(takeSensorEntity(child));
+    cmp::deleteEntity(entity); // Children were deleted first
+    return sensor;
+}
+
+void restoreSensorEntity(const SensorEntity& sensor, cmp::Entity parent) {
+    cmp::Entity entity = cmp::createEntity();
+    *entity.add<cmp::Transform>() = sensor.transform;
+    *entity.add<cmp::Name>() = sensor.name;
+    if (sensor.camera)
+        *entity.add<cmp::CameraSensor>() = *sensor.camera;
+    if (sensor.infrared)
+        *entity.add<cmp::InfraredSensor>() = *sensor.infrared;
+    cmp::Relationship::setParent(parent, entity);
+    for (const SensorEntity& child : sensor.children)
+        restoreSensorEntity(child, entity);
+}
+
 //---------- Project Script ----------//
 void ProjectScript::onLoad() {
+    // Materials of the extra object/goal pairs
+    for (unsigned k = 1; k < maxTasks; k++) {
+        atta::resource::Material::CreateInfo info{};
+        info.color = atta::vec3(objectColors[k].r, objectColors[k].g, objectColors[k].b) / 255.0f;
+        atta::resource::create<atta::resource::Material>(objectMaterials[k], info);
+        info.color = atta::vec3(goalColors[k].r, goalColors[k].g, goalColors[k].b) / 255.0f;
+        atta::resource::create<atta::resource::Material>(goalMaterials[k], info);
+    }
+
+    loadMaps();
+    _mapGeneratorParams = {};
     _currentExperiment = 0;
     _runExperiments = false;
+    _adaptiveRepetitions = false;
+    _traceEnabled = false;
+    _traceFirstStep = 0;
+    _traceLastStep = 1000;
+    _numTracesWritten = 0;
+    _numFlightRecordsWritten = 0;
+    _numReplaysWritten = 0;
+    _replayPlaying = false;
+    _replaySpeed = 1.0f;
+    _replayTime = 0.0f;
+    _replayLastWallTime = 0;
+    _seed = 0;
+    _currentSeed = 0;
+    _stateHashMode = StateHash::OFF;
+    _mergeWalls = true;
+    _lightweightPushers = false;
+    _batchJob = false;
+    _drawPath = true;
+    _drawDirections = true;
+    _numPathPointsDrawn = 0;
+    _drawRate = 30.0f;
+    _lastDrawTime = 0;
+    _lastDirectionsTime = 0;
+    _numTasks = 1;
     selectMap("reference");
     selectObject("circle");
     _currentInitialPos = "random";
+
+    // Headless evaluation started by the parameter optimizer
+    if (const char* job = std::getenv(batchJobEnv))
+        loadBatchJob(job);
 }
 
-void ProjectScript::onUnload() { resetMap(); }
+void ProjectScript::onUnload() {
+    setNumTasks(1);
+    resetMap();
+    setLightweightPushers(false); // Leave the prototype as it is stored in the project
+}
 
 void ProjectScript::onStart() {
+    Telemetry::reset();
+    AllocCounter::reset();
+    Lod::reset();
+    if (!_runExperiments)
+        _currentSeed = _seed;
+    srand(_currentSeed);
+    placeTasks();
     randomizePushers(_currentInitialPos);
+    _taskDoneTime.assign(taskObjects.size(), NAN);
 
-    // Make sure all cameras from the same pusher are synchronized
-    for (cmp::Entity pusher : cmp::getFactory(pusherProto)->getClones()) {
-        cmp::Entity cams = pusher.getChild(0);
-        auto cam0 = cams.getChild(0).get<cmp::CameraSensor>();
-        auto cam1 = cams.getChild(1).get<cmp::CameraSensor>();
-        auto cam2 = cams.getChild(2).get<cmp::CameraSensor>();
-        auto cam3 = cams.getChild(3).get<cmp::CameraSensor>();
-        cam3->captureTime = cam2->captureTime = cam1->captureTime = cam0->captureTime;
+    const std::vector<cmp::Entity>& pushers = cmp::getFactory(pusherProto)->getClones();
+    for (size_t i = 0; i < pushers.size(); i++) {
+        cmp::Entity pusher = pushers[i];
+        // Reset the state kept outside of the components, and split the pushers evenly among the tasks
+        PusherComponent::cold(pusher) = PusherComponent::Cold{};
+        PusherCommon::getCommand(pusher) = PusherCommon::Command{}; // Cached command of the previous run
+        pusher.get<PusherComponent>()->setTask(i % taskObjects.size());
+
+        // Lightweight pushers have a single panorama instead of the four cameras
+        PusherSensorsComponent* sensors = pusher.get<PusherSensorsComponent>();
+        std::array<cmp::CameraSensor*, 4> cams = {};
+        if (!sensors) {
+            cmp::Entity cameras = pusher.getChild(0);
+            for (int c = 0; c < 4; c++)
+                cams[c] = cameras.getChild(c).get<cmp::CameraSensor>();
+        }
+        PusherCommon::reserveScratch(pusher, sensors ? PusherSensorsComponent::panoramaWidth : cams[0]->width * 4);
+        const float fps = sensors ? sensors->fps : cams[0]->fps;
+        float captureTime = sensors ? -1.0f : cams[0]->captureTime;
+
+        // Spread the pushers evenly over the steps of the capture period, so they don't all capture in the same step
+        if (PusherCommon::getSettings().staggeredCapture && fps > 0.0f) {
+            const float dt = atta::Config::getDt();
+            const unsigned stepsPerPeriod = std::max(1l, std::lround(1.0f / (fps * dt)));
+            const unsigned slot = i * stepsPerPeriod / pushers.size();
+            captureTime = atta::Config::getTime() - (stepsPerPeriod - slot) * dt; // Next capture after slot steps
+        }
+
+        // Make sure all cameras from the same pusher are synchronized
+        if (sensors)
+            sensors->captureTime = captureTime;
+        else
+            for (cmp::CameraSensor* cam : cams)
+                cam->captureTime = captureTime;
     }
+
+    SensorModel::start(maps[_currentMap].arenaSize);
+    FlightRecorder::start();
+    MetricsSampler::start();
+    ChainAnalysis::start(maps[_currentMap].walls);
+
+    Replay::Info replayInfo;
+    replayInfo.map = _currentMap;
+    replayInfo.object = _currentObject;
+    replayInfo.goalX = goal.get<cmp::Transform>()->position.x;
+    replayInfo.goalY = goal.get<cmp::Transform>()->position.y;
+    replayInfo.goalRadius = goal.get<cmp::Transform>()->scale.x * 0.5f;
+    replayInfo.objectRadius = object.get<cmp::Transform>()->scale.x * 0.5f;
+    replayInfo.pusherRadius = pusherProto.get<cmp::Transform>()->scale.x * 0.5f;
+    Replay::start(replayInfo);
+
+    // Hashes are stored per configuration and seed, so a run can be verified against any earlier run with the same
+    // configuration and seed. The name has the main parameters and a hash of everything that changes the simulated behavior
+    nlohmann::json runConfig = {};
+    runConfig["map"] = _currentMap;
+    runConfig["mergeWalls"] = _mergeWalls;
+    runConfig["object"] = _currentObject;
+    runConfig["numTasks"] = taskObjects.size();
+    runConfig["controller"] = _currentScript;
+    runConfig["controllerParams"] = ControllerParams::toJson(PusherCommon::getParams());
+    runConfig["numRobots"] = pushers.size();
+    runConfig["initialPos"] = _currentInitialPos;
+    runConfig["lightweightPushers"] = _lightweightPushers;
+    runConfig["frameSynchronous"] = PusherCommon::getSettings().frameSynchronous;
+    runConfig["irTolerance"] = PusherCommon::getSettings().irTolerance;
+    runConfig["batchedActuation"] = PusherCommon::getSettings().batchedActuation;
+    runConfig["staggeredCapture"] = PusherCommon::getSettings().staggeredCapture;
+    runConfig["lod"] = Lod::getSettings().enabled;
+    runConfig["timeStep"] = atta::Config::getDt();
+    char configHash[17];
+    std::snprintf(configHash, sizeof(configHash), "%016llx", (unsigned long long)StateHash::hashConfig(runConfig.dump()));
+    std::string hashFile = "experiments/hashes-" + _currentMap + "-" + _currentObject + "-" + std::to_string(taskObjects.size()) + "_tasks-" +
+                           _currentScript + "-" + std::to_string(pushers.size()) + "_robots-" + configHash + "-seed_" +
+                           std::to_string(_currentSeed) + ".bin";
+    if (_stateHashMode != StateHash::OFF)
+        fs::create_directory("experiments");
+    StateHash::start(StateHash::Mode(_stateHashMode), hashFile);
 }
 
 void ProjectScript::onStop() {
+    // Save trace recorded during the simulation
+    if (Trace::getNumEvents() > 0) {
+        fs::create_directory("experiments");
+        fs::path file = fs::path("experiments") / std::string("trace-" + _currentMap + "-" + _currentScript + "-" +
+                                                              std::to_string(cmp::getFactory(pusherProto)->getClones().size()) + "_robots-" +
+                                                              std::to_string(_numTracesWritten++) + ".json");
+        if (Trace::write(file.string()))
+            LOG_INFO("ProjectScript", "Trace saved to [w]$0[] ($1 events, $2 dropped)", fs::absolute(file), Trace::getNumEvents(),
+                     Trace::getNumDropped());
+        else
+            LOG_WARN("ProjectScript", "Failed to save trace to [w]$0", fs::absolute(file));
+        Trace::clear();
+    }
+
+    // Restore the camera rates changed by the level of detail
+    Lod::reset();
+    _taskDoneTime.clear();
+
+    // Save replay and state hashes of interactive runs (experiments save them before stopping)
+    writeReplay();
+    finishStateHash();
+
     selectMap(_currentMap);
     gfx::Drawer::clear("teleop");
 }
 
 void ProjectScript::onAttaLoop() {
     if (atta::Config::getState() == atta::Config::State::RUNNING) {
+        PusherCommon::flushCommands(); // Commands left queued if the last pusher was not updated last
+        Telemetry::onLoop();
+        AllocCounter::onStep();
+        updateTasks();
         atta::vec2 objPos = atta::vec2(object.get<cmp::Transform>()->position);
         if (_objectPath.empty() || length(objPos - _objectPath.back()) >= 0.01)
             _objectPath.push_back(objPos);
+
+        FlightRecorder::record();
+        MetricsSampler::sample();
+        ChainAnalysis::update();
+        Replay::record();
+        StateHash::onStep();
+        if (const char* reason = FlightRecorder::pollTrigger())
+            dumpFlightRecorder(reason);
     }
 
+    // The experiment state machine runs with the simulation steps instead of the project UI callback. atta still renders the UI
+    // on every loop, so the step rate is still bounded by the rendering
+    runExperiments();
+
+    // Debug drawing at a capped wall-clock rate, from the state of the last step. This only limits the lines this project adds
+    // to the drawer, not the rendering done by atta
+    const uint64_t now = Telemetry::now();
+    if (_drawRate > 0.0f && now - _lastDrawTime < uint64_t(1e9f / _drawRate))
+        return;
+    _lastDrawTime = now;
+    Telemetry::ScopedStage stage(Telemetry::UI);
     drawerPusherLines();
     drawerPathLines();
+    drawerReplay();
 }
 
 void ProjectScript::onUIRender() {
+    Telemetry::ScopedStage stage(Telemetry::UI);
     ImGui::SetNextWindowSize(ImVec2(310, 300), ImGuiCond_Once);
     ImGui::Begin("Project");
     {
         uiControl();
         ImGui::Separator();
         uiExperiment();
-        runExperiments();
+        ImGui::Separator();
+        uiTrace();
+        ImGui::Separator();
+        uiFlightRecorder();
+        ImGui::Separator();
+        uiMetrics();
+        ImGui::Separator();
+        uiReplay();
+        ImGui::Separator();
+        uiDeterminism();
+        ImGui::Separator();
+        uiMapGenerator();
+        ImGui::Separator();
+        uiControllerParams();
         ImGui::Separator();
         uiPusherInspector();
     }
     ImGui::End();
 }
 
+void ProjectScript::loadMaps() {
+    std::vector<std::string> invalidFiles;
+    for (auto& [name, map] : MapFile::loadDirectory(mapsDirectory.string(), invalidFiles)) {
+        maps[name] = map;
+        mapFiles[name] = (mapsDirectory / (name + MapFile::extension)).string();
+    }
+    for (const std::string& file : invalidFiles)
+        LOG_WARN("ProjectScript", "Skipped invalid map file [w]$0", fs::absolute(file));
+    // Generated maps are stored in the maps directory. A missing one is generated again, but only saved outside of batch jobs
+    // (the optimizer runs several job processes at the same time)
+    const bool batchProcess = std::getenv(batchJobEnv) != nullptr;
+    for (const auto& [name, params] : generatedMaps) {
+        if (mapFiles.count(name))
+            continue;
+        if (batchProcess)
+            maps[name] = MapGenerator::generate(params);
+        else
+            saveMap(name, MapGenerator::generate(params));
+    }
+    PathOracle::clearCache();
+    LOG_INFO("ProjectScript", "Loaded [w]$0[] map files from [w]$1", mapFiles.size(), fs::absolute(mapsDirectory));
+}
+
+void ProjectScript::saveMap(std::string mapName, const MapInfo& map) {
+    maps[mapName] = map;
+    fs::create_directory(mapsDirectory);
+    fs::path file = mapsDirectory / (mapName + MapFile::extension);
+    if (MapFile::save(file.string(), map))
+        mapFiles[mapName] = file.string();
+    else
+        LOG_WARN("ProjectScript", "Could not save map [w]$0[] to [w]$1", mapName, fs::absolute(file));
+    PathOracle::clearCache();
+}
+
 void ProjectScript::selectMap(std::string mapName) {
+    auto it = maps.find(mapName);
+    if (it == maps.end()) {
+        LOG_ERROR("ProjectScript", "Unknown map [w]$0[], check the [w]$1[] directory", mapName, fs::absolute(mapsDirectory));
+        // A batch job would report the results of another map
+        if (_batchJob)
+            finishBatchJob("Unknown map " + mapName);
+        return;
+    }
     resetMap();
-    _objectPath.clear();
-    MapInfo map = maps[mapName];
+    clearObjectPath();
+    MapInfo map = it->second;
 
     // Move goal/object
     cmp::Transform* ot = object.get<cmp::Transform>();
@@ -327,14 +650,16 @@ void ProjectScript::selectMap(std::string mapName) {
     gt->position = atta::vec3(map.goalPos, gt->position.z);
     gt->orientation.set2DAngle(0.0f);
 
+    resizeArena(map.arenaSize);
+
     // Create obstacles
     cmp::Relationship* obstR = obstacles.get<cmp::Relationship>();
-    for (WallInfo wi : map.walls) {
+    for (WallInfo wi : _mergeWalls ? mergeColinearWalls(map.walls) : map.walls) {
         cmp::Entity wall = cmp::createEntity();
         cmp::Transform* t = wall.add<cmp::Transform>();
         t->position = atta::vec3(wi.pos, 0.1f);
         t->scale = atta::vec3(wi.size, 0.2f);
-        t->orientation.set2DAngle(0.0f);
+        t->orientation.set2DAngle(wi.angle);
         wall.add<cmp::Mesh>()->set("meshes/cube.obj");
         wall.add<cmp::Material>()->set("obstacle");
         wall.add<cmp::Name>()->set("Map wall");
@@ -346,11 +671,45 @@ void ProjectScript::selectMap(std::string mapName) {
     }
 
     _currentMap = mapName;
+    placeTasks();
 
     if (atta::Config::getState() != atta::Config::State::IDLE)
         randomizePushers(_currentInitialPos);
 }
 
+void ProjectScript::resizeArena(atta::vec2 arenaSize) {
+    // The first four obstacles are the arena border, their inner faces define the current arena size
+    std::vector<cmp::Entity> border = obstacles.get<cmp::Relationship>()->getChildren();
+    border.resize(std::min<size_t>(border.size(), 4));
+    atta::vec2 oldSize(0.0f);
+    for (cmp::Entity wall : border) {
+        cmp::Transform* t = wall.get<cmp::Transform>();
+        if (t->scale.x > t->scale.y)
+            oldSize.y = std::max(oldSize.y, 2.0f * (std::abs(t->position.y) - t->scale.y * 0.5f));
+        else
+            oldSize.x = std::max(oldSize.x, 2.0f * (std::abs(t->position.x) - t->scale.x * 0.5f));
+    }
+    if (oldSize.x == arenaSize.x && oldSize.y == arenaSize.y)
+        return;
+
+    for (cmp::Entity wall : border) {
+        cmp::Transform* t = wall.get<cmp::Transform>();
+        if (t->scale.x > t->scale.y) {
+            t->position.y = std::copysign(arenaSize.y * 0.5f + t->scale.y * 0.5f, t->position.y);
+            t->scale.x = arenaSize.x + 2.0f * t->scale.y;
+        } else {
+            t->position.x = std::copysign(arenaSize.x * 0.5f + t->scale.x * 0.5f, t->position.x);
+            t->scale.y = arenaSize.y + 2.0f * t->scale.x;
+        }
+    }
+
+    cmp::Transform* gt = ground.get<cmp::Transform>();
+    if (oldSize.x > 0.0f && oldSize.y > 0.0f) {
+        gt->scale.x *= arenaSize.x / oldSize.x;
+        gt->scale.y *= arenaSize.y / oldSize.y;
+    }
+}
+
 void ProjectScript::resetMap() {
     // Move to goal/obstacle to center
     cmp::Transform* ot = object.get<cmp::Transform>();
@@ -366,48 +725,160 @@ void ProjectScript::resetMap() {
 }
 
 void ProjectScript::selectObject(std::string objectName) {
-    constexpr float objectMass = 5.0f;
     cmp::Transform oldT = *object.get<cmp::Transform>();
     cmp::RigidBody2D oldRB = *object.get<cmp::RigidBody2D>();
     cmp::deleteEntity(object);
     cmp::createEntity(object);
     *(object.add<cmp::Transform>()) = oldT;
     *(object.add<cmp::RigidBody2D>()) = oldRB;
-    object.get<cmp::RigidBody2D>()->mass = objectMass;
-    object.add<cmp::Name>()->set("Object");
-    object.add<cmp::Material>()->set("object");
+    createObject(object, 0, objectName);
+    _currentObject = objectName;
+
+    // The objects of the other tasks have the same shape
+    setNumTasks(_numTasks);
+}
+
+void ProjectScript::createObject(cmp::Entity obj, unsigned task, std::string objectName) {
+    constexpr float objectMass = 5.0f;
+    obj.get<cmp::RigidBody2D>()->mass = objectMass;
+    obj.add<cmp::Name>()->set(task == 0 ? "Object" : "Object " + std::to_string(task));
+    obj.add<cmp::Material>()->set(objectMaterials[task]);
 
     if (objectName == "square" || objectName == "rectangle") {
-        object.get<cmp::Transform>()->scale = objectName == "square" ? atta::vec3(0.4f, 0.4f, 0.2f) : atta::vec3(0.6f, 0.15f, 0.2f);
-        object.add<cmp::Mesh>()->set("meshes/cube.obj");
-        object.add<cmp::BoxCollider2D>();
+        obj.get<cmp::Transform>()->scale = objectName == "square" ? atta::vec3(0.4f, 0.4f, 0.2f) : atta::vec3(0.6f, 0.15f, 0.2f);
+        obj.add<cmp::Mesh>()->set("meshes/cube.obj");
+        obj.add<cmp::BoxCollider2D>();
     } else if (objectName == "circle") {
-        object.get<cmp::Transform>()->scale = {0.4f, 0.4f, 0.2f};
-        object.add<cmp::Mesh>()->set("meshes/cylinder.obj");
-        object.add<cmp::CircleCollider2D>();
+        obj.get<cmp::Transform>()->scale = {0.4f, 0.4f, 0.2f};
+        obj.add<cmp::Mesh>()->set("meshes/cylinder.obj");
+        obj.add<cmp::CircleCollider2D>();
     } else if (objectName == "triangle") {
-        object.get<cmp::Transform>()->scale = {0.5f, 0.5f, 0.2f};
-        object.add<cmp::Mesh>()->set("triangle-object.obj");
-        object.add<cmp::PolygonCollider2D>()->points = {{0.2, 0.2}, {-0.4, 0.2}, {0.2, -0.6}, {0.2, 0.2}};
+        obj.get<cmp::Transform>()->scale = {0.5f, 0.5f, 0.2f};
+        obj.add<cmp::Mesh>()->set("triangle-object.obj");
+        obj.add<cmp::PolygonCollider2D>()->points = {{0.2, 0.2}, {-0.4, 0.2}, {0.2, -0.6}, {0.2, 0.2}};
     } else if (objectName == "plus") {
-        object.get<cmp::Transform>()->scale = atta::vec3(0.4f, 0.4f, 0.2f);
-        object.add<cmp::Mesh>()->set("plus-object.obj");
-        object.add<cmp::PolygonCollider2D>()->points = {{-0.05, 0.5},  {-0.05, 0.05}, {-0.5, 0.05},  {-0.5, -0.05}, {-0.05, -0.05},
-                                                        {-0.05, -0.5}, {0.05, -0.5},  {0.05, -0.05}, {0.5, -0.05},  {0.5, 0.05},
-                                                        {0.05, 0.05},  {0.05, 0.5},   {-0.05, 0.5}};
+        obj.get<cmp::Transform>()->scale = atta::vec3(0.4f, 0.4f, 0.2f);
+        obj.add<cmp::Mesh>()->set("plus-object.obj");
+        obj.add<cmp::PolygonCollider2D>()->points = {{-0.05, 0.5},  {-0.05, 0.05}, {-0.5, 0.05},  {-0.5, -0.05}, {-0.05, -0.05},
+                                                     {-0.05, -0.5}, {0.05, -0.5},  {0.05, -0.05}, {0.5, -0.05},  {0.5, 0.05},
+                                                     {0.05, 0.05},  {0.05, 0.5},   {-0.05, 0.5}};
     } else if (objectName == "H") {
-        object.get<cmp::Transform>()->scale = atta::vec3(0.4f, 0.4f, 0.2f);
-        object.add<cmp::Mesh>()->set("H-object.obj");
-        object.add<cmp::PolygonCollider2D>()->points = {{0.4, 0.05},  {-0.4, 0.05},  {-0.4, 0.5},  {-0.5, 0.5}, {-0.5, -0.5},
-                                                        {-0.4, -0.5}, {-0.4, -0.05}, {0.4, -0.05}, {0.4, -0.5}, {0.5, -0.5},
-                                                        {0.5, 0.5},   {0.4, 0.5},    {0.4, 0.05}};
+        obj.get<cmp::Transform>()->scale = atta::vec3(0.4f, 0.4f, 0.2f);
+        obj.add<cmp::Mesh>()->set("H-object.obj");
+        obj.add<cmp::PolygonCollider2D>()->points = {{0.4, 0.05},  {-0.4, 0.05},  {-0.4, 0.5},  {-0.5, 0.5}, {-0.5, -0.5},
+                                                     {-0.4, -0.5}, {-0.4, -0.05}, {0.4, -0.05}, {0.4, -0.5}, {0.5, -0.5},
+                                                     {0.5, 0.5},   {0.4, 0.5},    {0.4, 0.05}};
     } else if (objectName == "L") {
-        object.get<cmp::Transform>()->scale = atta::vec3(0.4f, 0.4f, 0.2f);
-        object.add<cmp::Mesh>()->set("L-object.obj");
-        object.add<cmp::PolygonCollider2D>()->points = {{-0.4, 0.5}, {-0.5, 0.5}, {-0.5, -0.5}, {0.5, -0.5}, {0.5, -0.4}, {-0.4, -0.4}, {-0.4, 0.5}};
+        obj.get<cmp::Transform>()->scale = atta::vec3(0.4f, 0.4f, 0.2f);
+        obj.add<cmp::Mesh>()->set("L-object.obj");
+        obj.add<cmp::PolygonCollider2D>()->points = {{-0.4, 0.5}, {-0.5, 0.5}, {-0.5, -0.5}, {0.5, -0.5}, {0.5, -0.4}, {-0.4, -0.4}, {-0.4, 0.5}};
     }
+}
 
-    _currentObject = objectName;
+void ProjectScript::setNumTasks(int numTasks) {
+    _numTasks = std::clamp(numTasks, 1, int(maxTasks));
+    if (atta::Config::getState() != atta::Config::State::IDLE)
+        return;
+
+    // Recreate the extra pairs, copying the scene object and goal
+    for (size_t k = 1; k < taskObjects.size(); k++) {
+        cmp::deleteEntity(taskObjects[k]);
+        cmp::deleteEntity(taskGoals[k]);
+    }
+    taskObjects.resize(1);
+    taskGoals.resize(1);
+    for (int k = 1; k < _numTasks; k++) {
+        cmp::Entity obj = cmp::createEntity();
+        *obj.add<cmp::Transform>() = *object.get<cmp::Transform>();
+        *obj.add<cmp::RigidBody2D>() = *object.get<cmp::RigidBody2D>();
+        createObject(obj, k, _currentObject);
+        taskObjects.push_back(obj);
+
+        cmp::Entity g = cmp::createEntity();
+        *g.add<cmp::Transform>() = *goal.get<cmp::Transform>();
+        *g.add<cmp::Mesh>() = *goal.get<cmp::Mesh>();
+        g.add<cmp::Material>()->set(goalMaterials[k]);
+        g.add<cmp::Name>()->set("Goal " + std::to_string(k));
+        taskGoals.push_back(g);
+    }
+    SensorModel::setTasks(taskObjects, taskGoals);
+    placeTasks();
+}
+
+void ProjectScript::placeTasks() {
+    if (taskObjects.size() == 1)
+        return;
+
+    // The map defines the first pair, the others are placed at random free positions
+    const MapInfo& map = maps[_currentMap];
+    const atta::vec2 halfSize = map.arenaSize * 0.5f;
+    const float objectRadius = getObjectRadius() + pusherProto.get<cmp::Transform>()->scale.x; // Room to move around the object
+    const float goalRadius = goal.get<cmp::Transform>()->scale.x * 0.5f;
+    const float minObjectGoalDist = 0.25f * std::min(map.arenaSize.x, map.arenaSize.y);
+    std::vector<std::pair<atta::vec2, float>> placed = {{map.objectPos, objectRadius}, {map.goalPos, goalRadius}};
+    auto randomFreePosition = [&](float radius) {
+        atta::vec2 pos(0.0f);
+        for (size_t numTries = 10000; numTries > 0; numTries--) {
+            pos.x = (rand() / float(RAND_MAX) * 2.0f - 1.0f) * (halfSize.x - radius);
+            pos.y = (rand() / float(RAND_MAX) * 2.0f - 1.0f) * (halfSize.y - radius);
+            bool free = !overlapsWalls(map.walls, pos, radius);
+            for (const auto& [p, r] : placed)
+                free = free && (p - pos).length() >= r + radius;
+            if (free)
+                return pos;
+        }
+        LOG_WARN("ProjectScript", "Failed to find free position for object/goal");
+        return pos;
+    };
+
+    for (size_t k = 1; k < taskObjects.size(); k++) {
+        atta::vec2 objectPos, goalPos;
+        for (int numTries = 100; numTries > 0; numTries--) {
+            objectPos = randomFreePosition(objectRadius);
+            goalPos = randomFreePosition(goalRadius);
+            if ((goalPos - objectPos).length() >= minObjectGoalDist)
+                break;
+        }
+        placed.push_back({objectPos, objectRadius});
+        placed.push_back({goalPos, goalRadius});
+
+        cmp::Transform* ot = taskObjects[k].get<cmp::Transform>();
+        ot->position = atta::vec3(objectPos, ot->position.z);
+        ot->orientation.set2DAngle(0.0f);
+        cmp::Transform* gt = taskGoals[k].get<cmp::Transform>();
+        gt->position = atta::vec3(goalPos, gt->position.z);
+    }
+}
+
+void ProjectScript::updateTasks() {
+    const float minDist = getMinObjectGoalDist();
+    bool newDone = false;
+    for (size_t k = 0; k < _taskDoneTime.size(); k++) {
+        atta::vec2 objPos = atta::vec2(taskObjects[k].get<cmp::Transform>()->position);
+        atta::vec2 goalPos = atta::vec2(taskGoals[k].get<cmp::Transform>()->position);
+        if (std::isnan(_taskDoneTime[k]) && (objPos - goalPos).length() <= minDist) {
+            _taskDoneTime[k] = atta::Config::getTime();
+            newDone = true;
+        }
+    }
+    if (!newDone)
+        return;
+
+    // Pushers of delivered objects move on to the remaining tasks
+    std::vector<unsigned> remaining;
+    for (size_t k = 0; k < _taskDoneTime.size(); k++)
+        if (std::isnan(_taskDoneTime[k]))
+            remaining.push_back(k);
+    if (remaining.empty())
+        return;
+    unsigned next = 0;
+    for (cmp::Entity pusher : cmp::getFactory(pusherProto)->getClones()) {
+        PusherComponent* pc = pusher.get<PusherComponent>();
+        if (!std::isnan(_taskDoneTime[pc->task()])) {
+            pc->setTask(remaining[next++ % remaining.size()]);
+            PusherCommon::changeState(pc, PusherComponent::RANDOM_WALK);
+        }
+    }
 }
 
 void ProjectScript::selectScript(std::string scriptName) {
@@ -415,18 +886,44 @@ void ProjectScript::selectScript(std::string scriptName) {
     _currentScript = scriptName;
 }
 
+void ProjectScript::setLightweightPushers(bool lightweight) {
+    _lightweightPushers = lightweight;
+    const bool stripped = !pusherSensorEntities.empty();
+    if (lightweight == stripped || atta::Config::getState() != atta::Config::State::IDLE)
+        return;
+
+    if (lightweight) {
+        // Keep the sensor configuration of the prototype, then remove its camera/infrared children
+        cmp::Entity cameras = pusherProto.getChild(0);
+        cmp::Entity infrareds = pusherProto.getChild(1);
+        PusherSensorsComponent* sensors = pusherProto.add<PusherSensorsComponent>();
+        *sensors = PusherSensorsComponent{};
+        sensors->fps = cameras.getChild(0).get<cmp::CameraSensor>()->fps;
+        sensors->irRange = infrareds.getChild(0).get<cmp::InfraredSensor>()->upperLimit;
+        sensors->irs.fill(sensors->irRange);
+
+        for (cmp::Entity child : pusherProto.get<cmp::Relationship>()->getChildren()) {
+            pusherProto.get<cmp::Relationship>()->removeChild(pusherProto, child);
+            pusherSensorEntities.push_back(takeSensorEntity(child));
+        }
+    } else {
+        for (const SensorEntity& sensor : pusherSensorEntities)
+            restoreSensorEntity(sensor, pusherProto);
+        pusherSensorEntities.clear();
+        pusherProto.remove<PusherSensorsComponent>();
+    }
+}
+
 void ProjectScript::randomizePushers(std::string initialPos) {
     _currentInitialPos = initialPos;
     if (atta::Config::getState() == atta::Config::State::IDLE)
         return;
 
-    constexpr float worldSize = 2.9f;
+    const atta::vec2 worldSize = maps[_currentMap].arenaSize - atta::vec2(0.1f, 0.1f);
     const float pusherRadius = pusherProto.get<cmp::Transform>()->scale.x * 0.5f;
     const float gap = pusherRadius;
-    atta::vec2 goalPos = maps[_currentMap].goalPos;
-    float goalRadius = goal.get<cmp::Transform>()->scale.x * 0.5f;
-    atta::vec2 objectPos = maps[_currentMap].objectPos;
-    atta::vec2 objectSize = object.get<cmp::Transform>()->scale;
+    const float goalRadius = goal.get<cmp::Transform>()->scale.x * 0.5f;
+    const float objectRadius = object.get<cmp::Transform>()->scale.x * sqrt(2) * 0.5;
 
     std::vector<WallInfo> walls = maps[_currentMap].walls;
     std::vector<atta::vec2> pusherPositions;
@@ -438,48 +935,37 @@ void ProjectScript::randomizePushers(std::string initialPos) {
         while (!freePosition && --numTries > 0) {
             freePosition = true;
             // Get random position (lower-left of the map)
-            float rx = rand() / float(RAND_MAX) * worldSize - worldSize * 0.5f;
+            float rx = rand() / float(RAND_MAX) * worldSize.x - worldSize.x * 0.5f;
             float ry = 0.0f;
             if (initialPos == "random")
-                ry = rand() / float(RAND_MAX) * worldSize - worldSize * 0.5f;
+                ry = rand() / float(RAND_MAX) * worldSize.y - worldSize.y * 0.5f;
             else if (initialPos == "top")
-                ry = rand() / float(RAND_MAX) * worldSize * 0.25f + worldSize * 0.25f;
+                ry = rand() / float(RAND_MAX) * worldSize.y * 0.25f + worldSize.y * 0.25f;
             else if (initialPos == "bottom")
-                ry = rand() / float(RAND_MAX) * worldSize * 0.25f - worldSize * 0.5f;
+                ry = rand() / float(RAND_MAX) * worldSize.y * 0.25f - worldSize.y * 0.5f;
             else
                 LOG_WARN("ProjectScript", "Unknown initial position option [w]$0", initialPos);
             pos = {rx, ry};
 
-            // Check goal collision
-            float dist = (goalPos - pos).length();
-            if (dist < goalRadius + pusherRadius + gap) {
-                freePosition = false;
-                continue;
+            // Check goal and object collision
+            for (size_t k = 0; k < taskObjects.size() && freePosition; k++) {
+                atta::vec2 goalPos = k == 0 ? maps[_currentMap].goalPos : atta::vec2(taskGoals[k].get<cmp::Transform>()->position);
+                atta::vec2 objectPos = k == 0 ? maps[_currentMap].objectPos : atta::vec2(taskObjects[k].get<cmp::Transform>()->position);
+                if ((goalPos - pos).length() < goalRadius + pusherRadius + gap || (pos - objectPos).length() < objectRadius + pusherRadius + gap)
+                    freePosition = false;
             }
-
-            // Check object collision
-            dist = (pos - objectPos).length();
-            if (dist < objectSize.x * sqrt(2) * 0.5 + pusherRadius + gap) {
-                freePosition = false;
+            if (!freePosition)
                 continue;
-            }
 
             // Check wall collision
-            for (WallInfo wall : walls) {
-                float wallMinX = wall.pos.x - wall.size.x * 0.5;
-                float wallMaxX = wall.pos.x + wall.size.x * 0.5;
-                float wallMinY = wall.pos.y - wall.size.y * 0.5;
-                float wallMaxY = wall.pos.y + wall.size.y * 0.5;
-                if (pos.x + pusherRadius + gap >= wallMinX && pos.x - pusherRadius - gap <= wallMaxX && pos.y + pusherRadius + gap >= wallMinY &&
-                    pos.y - pusherRadius - gap <= wallMaxY) {
-                    freePosition = false;
-                    continue;
-                }
+            if (overlapsWalls(walls, pos, pusherRadius + gap)) {
+                freePosition = false;
+                continue;
             }
 
             // Check robot collision
             for (atta::vec2 o : pusherPositions) {
-                dist = (o - pos).length();
+                float dist = (o - pos).length();
                 if (dist < 2 * pusherRadius + gap) {
                     freePosition = false;
                     continue;
@@ -497,3 +983,150 @@ void ProjectScript::randomizePushers(std::string initialPos) {
 
 #include "projectScriptExperiments.cpp"
 #include "projectScriptUI.cpp"
+
+std::string ProjectScript::dumpFlightRecorder(std::string reason) {
+    if (FlightRecorder::getNumFrames() == 0)
+        return "";
+
+    fs::create_directory("experiments");
+    fs::path file = fs::path("experiments") / std::string("flight-" + _currentMap + "-" + _currentScript + "-" +
+                                                          std::to_string(cmp::getFactory(pusherProto)->getClones().size()) + "_robots-" +
+                                                          std::to_string(_numFlightRecordsWritten++) + "-" + reason + ".bin");
+    if (!FlightRecorder::dump(file.string())) {
+        LOG_WARN("ProjectScript", "Failed to save flight recorder to [w]$0", fs::absolute(file));
+        return "";
+    }
+    LOG_INFO("ProjectScript", "Flight recorder saved to [w]$0[] ($1 frames, trigger: $2)", fs::absolute(file), FlightRecorder::getNumFrames(),
+             reason);
+    return file.string();
+}
+
+std::string ProjectScript::writeReplay() {
+    if (Replay::getNumFrames() == 0)
+        return "";
+
+    fs::create_directory("experiments");
+    fs::path file = fs::path("experiments") / std::string("replay-" + _currentMap + "-" + _currentScript + "-" +
+                                                          std::to_string(cmp::getFactory(pusherProto)->getClones().size()) + "_robots-" +
+                                                          std::to_string(_numReplaysWritten++) + ".bpr");
+    bool ok = Replay::write(file.string());
+    Replay::clear();
+    if (!ok) {
+        LOG_WARN("ProjectScript", "Failed to save replay to [w]$0", fs::absolute(file));
+        return "";
+    }
+    LOG_INFO("ProjectScript", "Replay saved to [w]$0", fs::absolute(file));
+    return file.string();
+}
+
+void ProjectScript::loadBatchJob(std::string file) {
+    std::ifstream in(file);
+    nlohmann::json job = nlohmann::json::parse(in, nullptr, false);
+    if (job.is_discarded() || !job.contains("experiments") || !job.contains("output")) {
+        LOG_ERROR("ProjectScript", "Invalid batch job [w]$0", file);
+        _batchJob = true;
+        _batchOutput = job.is_object() ? job.value("output", "") : "";
+        finishBatchJob("Invalid batch job " + file);
+        return;
+    }
+
+    PusherCommon::getParams() = ControllerParams::fromJson(job.value("params", nlohmann::json::object()));
+    _seed = job.value("seed", 0);
+    setLightweightPushers(job.value("lightweightPushers", false));
+    Lod::getSettings().enabled = job.value("lod", false);
+    experiments.clear();
+    for (const nlohmann::json& e : job["experiments"])
+        experiments.push_back({.numRepetitions = 1,
+                               .numRobots = e.value("numRobots", 20),
+                               .timeout = e.value("timeout", gTimeout),
+                               .map = e.value("map", "reference"),
+                               .object = e.value("object", "square"),
+                               .initialPos = e.value("initialPos", "random"),
+                               .script = e.value("script", "PusherScript"),
+                               .numTasks = e.value("numTasks", 1)});
+
+    _batchJob = true;
+    _drawPath = false;
+    _drawDirections = false;
+    _batchOutput = job["output"];
+    _batchResults = nlohmann::json::array();
+    _runExperiments = true;
+    _currentExperiment = 0;
+    _currentRepetition = 0;
+    _experimentResults["config"] = {};
+    _experimentResults["repetitions"] = {};
+    LOG_INFO("ProjectScript", "Running batch job [w]$0[] with [w]$1[] experiments", file, experiments.size());
+}
+
+void ProjectScript::finishBatchJob(std::string error) {
+    _runExperiments = false;
+    if (!_batchOutput.empty()) {
+        nlohmann::json result = {};
+        result["params"] = ControllerParams::toJson(PusherCommon::getParams());
+        result["seed"] = _seed;
+        result["experiments"] = _batchResults;
+        result["complete"] = error.empty(); // Checked by the optimizer, atta exits with status 0 after a normal shutdown
+        if (!error.empty())
+            result["error"] = error;
+        std::ofstream out(_batchOutput);
+        out << result;
+        if (out)
+            LOG_INFO("ProjectScript", "Batch job finished, results saved to [w]$0", fs::absolute(_batchOutput));
+        else
+            LOG_ERROR("ProjectScript", "Could not save batch job results to [w]$0", fs::absolute(_batchOutput));
+    }
+
+    // Each job is a separate process, the optimizer waits for it to exit. Closing the window ends the atta loop, which then
+    // stops the simulation and unloads the project as usual
+    evt::WindowClose e;
+    evt::publish(e);
+}
+
+nlohmann::json ProjectScript::finishStateHash() {
+    StateHash::Mode mode = StateHash::getMode();
+    if (mode == StateHash::OFF)
+        return {};
+
+    StateHash::Divergence divergence = StateHash::finish();
+    nlohmann::json result = {{"mode", StateHash::modeNames[mode]}, {"seed", _currentSeed}};
+    if (!divergence.error.empty()) {
+        LOG_WARN("ProjectScript", "State hash: $0", divergence.error);
+        result["error"] = divergence.error;
+    } else if (mode == StateHash::VERIFY) {
+        if (divergence.diverged)
+            LOG_ERROR("ProjectScript", "State diverged from reference at step $0 (entity $1)", divergence.step, divergence.entity);
+        else
+            LOG_INFO("ProjectScript", "State matches reference (seed $0)", _currentSeed);
+        result["diverged"] = divergence.diverged;
+        if (divergence.diverged) {
+            result["step"] = divergence.step;
+            result["entity"] = divergence.entity;
+        }
+    }
+    return result;
+}
+
+float ProjectScript::getObjectRadius() {
+    // Radius of the disc that contains the object in any orientation
+    atta::vec3 scale = object.get<cmp::Transform>()->scale;
+    if (object.get<cmp::CircleCollider2D>())
+        return scale.x * 0.5f;
+    if (auto polygon = object.get<cmp::PolygonCollider2D>()) {
+        float radius = 0.0f;
+        for (atta::vec2 p : polygon->points)
+            radius = std::max(radius, std::hypot(p.x * scale.x, p.y * scale.y));
+        return radius;
+    }
+    return std::hypot(scale.x, scale.y) * 0.5f;
+}
+
+float ProjectScript::getMinObjectGoalDist() {
+    const atta::vec2 objScale = atta::vec2(object.get<cmp::Transform>()->scale.x);
+    const atta::vec2 goalScale = atta::vec2(goal.get<cmp::Transform>()->scale.x);
+    const float gap = 0.05;
+    if (_currentObject == "square" || _currentObject == "rectangle" || _currentObject == "H" || _currentObject == "L")
+        return (goalScale.x + objScale.length()) * 0.5 + gap;
+    else if (_currentObject == "circle" || _currentObject == "triangle" || _currentObject == "plus")
+        return (goalScale.x + objScale.x) * 0.5 + gap;
+    return 0.0f;
+}
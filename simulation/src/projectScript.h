@@ -5,9 +5,14 @@
 //--------------------------------------------------
 #ifndef PROJECT_SCRIPT_H
 #define PROJECT_SCRIPT_H
+#include "mapGenerator.h"
 #include "nlohmann/json.hpp"
+#include "replay.h"
+#include <atta/component/interface.h>
+#include <atta/graphics/drawer.h>
 #include <atta/script/projectScript.h>
 
+namespace cmp = atta::component;
 namespace scr = atta::script;
 
 class ProjectScript : public scr::ProjectScript {
@@ -24,13 +29,33 @@ class ProjectScript : public scr::ProjectScript {
 
   private:
     // Map handling
+    void loadMaps();
+    void saveMap(std::string mapName, const MapInfo& map);
     void selectMap(std::string mapName);
     void resetMap();
+    void resizeArena(atta::vec2 arenaSize);
     // Object handling
     void selectObject(std::string objectName);
+    float getObjectRadius();
+    float getMinObjectGoalDist(); // Object-goal distance considered success
+    void createObject(cmp::Entity obj, unsigned task, std::string objectName); // Components of an object, given its transform and rigid body
+    // Tasks (object/goal pairs)
+    void setNumTasks(int numTasks); // Recreate the extra pairs (only while idle)
+    void placeTasks();              // Random free positions for the extra pairs
+    void updateTasks();             // Mark delivered objects and reassign their pushers
     // Pusher handling
     void selectScript(std::string scriptName);
     void randomizePushers(std::string initalPos);
+    void setLightweightPushers(bool lightweight); // Replace the camera/infrared children by a PusherSensorsComponent (only while idle)
+    // Flight recorder
+    std::string dumpFlightRecorder(std::string reason);
+    // Replay
+    std::string writeReplay();
+    // Determinism
+    nlohmann::json finishStateHash();
+    // Batch jobs (headless candidate evaluations for the parameter optimizer)
+    void loadBatchJob(std::string file);
+    void finishBatchJob(std::string error = ""); // Writes the results (or the error) and asks atta to shut down
 
     //---------- Experiments ----------//
     void runExperiments();
@@ -41,14 +66,53 @@ class ProjectScript : public scr::ProjectScript {
     void uiPusherInspector();
     void drawerPusherLines();
     void drawerPathLines();
+    void clearObjectPath();
+    void uiTrace();
+    void uiFlightRecorder();
+    void uiMetrics();
+    void uiReplay();
+    void uiDeterminism();
+    void uiMapGenerator();
+    void uiControllerParams();
+    void drawerReplay();
 
     bool _runExperiments;
+    bool _adaptiveRepetitions; // Stop each experiment once the stopping rule is satisfied
+    bool _traceEnabled;
+    int _traceFirstStep;
+    int _traceLastStep;
+    int _numTracesWritten;
+    int _numFlightRecordsWritten;
+    int _numReplaysWritten;
+    Replay::Recording _replay; // Loaded recording for playback
+    bool _replayPlaying;
+    float _replaySpeed;
+    float _replayTime;
+    uint64_t _replayLastWallTime;
+    int _seed;             // Base seed, repetition i of an experiment uses _seed + i
+    unsigned _currentSeed; // Seed of the current run
+    int _stateHashMode;    // StateHash::Mode
+    MapGenerator::Params _mapGeneratorParams;
+    bool _mergeWalls;         // One body per run of colinear touching walls
+    bool _lightweightPushers; // Pushers without sensor child entities
+    bool _batchJob;           // Running a job file, results are written to _batchOutput and atta shuts down
+    bool _drawPath;           // Object path debug lines
+    bool _drawDirections;     // Goal/object/push direction debug lines of each pusher
+    std::vector<atta::graphics::Drawer::Line> _directionLines; // Last drawn direction lines, 3 per pusher
+    uint64_t _lastDirectionsTime;                              // Wall time of the last rebuild of the direction lines
+    size_t _numPathPointsDrawn;
+    float _drawRate;          // Updates per second of wall time of the project debug lines (0: every loop), atta rendering is not capped
+    uint64_t _lastDrawTime;
+    std::string _batchOutput;
+    nlohmann::json _batchResults;
     int _currentExperiment;
     int _currentRepetition;
     std::string _currentMap;
     std::string _currentObject;
     std::string _currentScript;
     std::string _currentInitialPos;
+    int _numTasks;
+    std::vector<float> _taskDoneTime; // Simulation time each object reached its goal (NAN while not delivered)
     std::vector<atta::vec2> _objectPath;
     nlohmann::json _experimentResults;
 };
@@ -11,22 +11,38 @@ void ProjectScript::runExperiments() {
 
         const atta::vec2 objPos = atta::vec2(object.get<cmp::Transform>()->position);
         const atta::vec2 goalPos = atta::vec2(goal.get<cmp::Transform>()->position);
-        const atta::vec2 objScale = atta::vec2(object.get<cmp::Transform>()->scale.x);
-        const atta::vec2 goalScale = atta::vec2(goal.get<cmp::Transform>()->scale.x);
         const float pusherDiam = pusherProto.get<cmp::Transform>()->scale.x;
-        const float gap = 0.05;
-        float minDist = 0.0f;
-        if (exp.object == "square" || exp.object == "rectangle" || exp.object == "H" || exp.object == "L")
-            minDist = (goalScale.x + objScale.length()) * 0.5 + gap;
-        else if (exp.object == "circle" || exp.object == "triangle" || exp.object == "plus")
-            minDist = (goalScale.x + objScale.x) * 0.5 + gap;
 
         // If last experiment finished (simulation not running), start new one
         if (atta::Config::getState() == atta::Config::State::IDLE) {
+            auto mapIt = maps.find(exp.map);
+            if (mapIt == maps.end()) {
+                LOG_WARN("ProjectScript", "Skipping experiment [w]$0[], unknown map [w]$1[] (check the [w]$2[] directory)", _currentExperiment,
+                         exp.map, fs::absolute(mapsDirectory));
+                // Keep the batch results aligned with the job experiments, the optimizer counts it as a failed run
+                if (_batchJob)
+                    _batchResults.push_back({{"error", "Unknown map " + exp.map}, {"repetitions", nlohmann::json::array()}});
+                _currentExperiment++;
+                _currentRepetition = 0;
+                if (_currentExperiment == experiments.size()) {
+                    _currentExperiment = 0;
+                    _runExperiments = false;
+                    if (_batchJob)
+                        finishBatchJob();
+                }
+                return;
+            }
+            const MapInfo& map = mapIt->second;
+
+            // Seed the run so the repetition can be reproduced
+            _currentSeed = _seed + _currentRepetition;
+            srand(_currentSeed);
+
             // Set parameters
             pusherProto.get<cmp::Prototype>()->maxClones = exp.numRobots;
             selectScript(exp.script);
             selectMap(exp.map);
+            _numTasks = exp.numTasks;
             selectObject(exp.object);
 
             // JSON config
@@ -34,33 +50,89 @@ void ProjectScript::runExperiments() {
                 nlohmann::json experimentConfig = {};
                 experimentConfig["numRepetitions"] = exp.numRepetitions;
                 experimentConfig["numRobots"] = exp.numRobots;
+                experimentConfig["numTasks"] = exp.numTasks;
                 experimentConfig["controller"] = exp.script;
+                experimentConfig["controllerParams"] = ControllerParams::toJson(PusherCommon::getParams());
+                experimentConfig["frameSynchronous"] = PusherCommon::getSettings().frameSynchronous;
+                experimentConfig["irTolerance"] = PusherCommon::getSettings().irTolerance;
+                experimentConfig["batchedActuation"] = PusherCommon::getSettings().batchedActuation;
+                experimentConfig["lod"] = Lod::getSettings().enabled;
+                experimentConfig["staggeredCapture"] = PusherCommon::getSettings().staggeredCapture;
+                experimentConfig["lightweightPushers"] = _lightweightPushers;
+                experimentConfig["seed"] = _seed;
+                experimentConfig["stateHash"] = StateHash::modeNames[_stateHashMode];
                 experimentConfig["map"] = {};
                 experimentConfig["map"]["name"] = exp.map;
-                experimentConfig["map"]["goal"] = {maps[exp.map].goalPos.x, maps[exp.map].goalPos.y};
-                experimentConfig["map"]["object"] = {maps[exp.map].objectPos.x, maps[exp.map].objectPos.y};
+                if (mapFiles.count(exp.map))
+                    experimentConfig["map"]["file"] = mapFiles[exp.map];
+                experimentConfig["map"]["arenaSize"] = {map.arenaSize.x, map.arenaSize.y};
+                experimentConfig["map"]["mergeWalls"] = _mergeWalls;
+                experimentConfig["map"]["goal"] = {map.goalPos.x, map.goalPos.y};
+                experimentConfig["map"]["object"] = {map.objectPos.x, map.objectPos.y};
                 experimentConfig["timeout"] = exp.timeout;
                 experimentConfig["timeStep"] = atta::Config::getDt();
-                experimentConfig["minObjectGoalDist"] = minDist;
+                experimentConfig["minObjectGoalDist"] = getMinObjectGoalDist();
+
+                // Reference for the path efficiency
+                const PathOracle::Result& optimal =
+                    PathOracle::getOptimalPath(exp.map, exp.object, map, getObjectRadius(), getMinObjectGoalDist());
+                if (!std::isnan(optimal.length)) {
+                    experimentConfig["optimalPathLength"] = optimal.length;
+                    experimentConfig["optimalPath"] = {};
+                    for (atta::vec2 p : optimal.path)
+                        experimentConfig["optimalPath"].push_back({p.x, p.y});
+                } else
+                    LOG_WARN("ProjectScript", "No path from object to goal in map [w]$0[] with object [w]$1", exp.map, exp.object);
+                if (_adaptiveRepetitions) {
+                    nlohmann::json rule = {};
+                    rule["type"] = "adaptive";
+                    rule["minRepetitions"] = gStoppingRule.minRepetitions;
+                    rule["maxRepetitions"] = exp.numRepetitions;
+                    rule["z"] = gStoppingRule.z;
+                    rule["successRateWidth"] = gStoppingRule.successRateWidth;
+                    rule["medianTimeWidth"] = gStoppingRule.medianTimeWidth;
+                    rule["minSuccessesForTime"] = gStoppingRule.minSuccessesForTime;
+                    experimentConfig["stoppingRule"] = rule;
+                } else
+                    experimentConfig["stoppingRule"] = {{"type", "fixed"}, {"numRepetitions", exp.numRepetitions}};
                 _experimentResults["config"] = experimentConfig;
             }
 
             // JSON repetition
             _experimentResults["repetitions"] += {};
+            _experimentResults["repetitions"].back()["seed"] = _currentSeed;
 
             // Start simulation
             evt::SimulationStart e;
             evt::publish(e);
         }
 
-        // Check stop condition
+        // Check stop condition (every object delivered)
         float dist = (objPos - goalPos).length();
-        bool success = dist <= minDist;
+        bool success = !_taskDoneTime.empty();
+        for (float t : _taskDoneTime)
+            success = success && !std::isnan(t);
         if (atta::Config::getTime() > exp.timeout || success) {
             // JSON log result
             _experimentResults["repetitions"].back()["success"] = success;
             _experimentResults["repetitions"].back()["time"] = atta::Config::getTime();
             _experimentResults["repetitions"].back()["distance"] = dist;
+            if (exp.numTasks > 1) {
+                // Delivery time of each pair and objects delivered per simulated hour
+                int numDone = 0;
+                _experimentResults["repetitions"].back()["tasks"] = nlohmann::json::array();
+                for (size_t k = 0; k < _taskDoneTime.size(); k++) {
+                    atta::vec2 o = atta::vec2(taskObjects[k].get<cmp::Transform>()->position);
+                    atta::vec2 g = atta::vec2(taskGoals[k].get<cmp::Transform>()->position);
+                    nlohmann::json task = {{"distance", (o - g).length()}};
+                    if (!std::isnan(_taskDoneTime[k])) {
+                        task["time"] = _taskDoneTime[k];
+                        numDone++;
+                    }
+                    _experimentResults["repetitions"].back()["tasks"].push_back(task);
+                }
+                _experimentResults["repetitions"].back()["throughput"] = numDone * 3600.0f / atta::Config::getTime();
+            }
             _experimentResults["repetitions"].back()["path"] = {};
             for (atta::vec2 pos : _objectPath) {
                 nlohmann::json jsonPos = {};
@@ -68,6 +140,91 @@ void ProjectScript::runExperiments() {
                 jsonPos += pos.y;
                 _experimentResults["repetitions"].back()["path"] += jsonPos;
             }
+            float pathLength = 0.0f;
+            for (size_t i = 1; i < _objectPath.size(); i++)
+                pathLength += (_objectPath[i] - _objectPath[i - 1]).length();
+            _experimentResults["repetitions"].back()["pathLength"] = pathLength;
+            if (success && _experimentResults["config"].contains("optimalPathLength") && pathLength > 0.0f) {
+                // Stored as is, a value above 1 means the oracle overestimated the optimal path
+                const float optimalPathLength = _experimentResults["config"]["optimalPathLength"];
+                const float pathEfficiency = optimalPathLength / pathLength;
+                _experimentResults["repetitions"].back()["pathEfficiency"] = pathEfficiency;
+                if (pathEfficiency > 1.0f)
+                    LOG_WARN("ProjectScript", "Path efficiency [w]$0[] above 1, object path [w]$1[] shorter than optimal path [w]$2[] ([w]$3[])",
+                             pathEfficiency, pathLength, optimalPathLength, exp.map);
+            }
+
+            // Keep the last seconds of failed repetitions for debugging
+            if (!success) {
+                std::string flightFile = dumpFlightRecorder("timeout");
+                if (!flightFile.empty())
+                    _experimentResults["repetitions"].back()["flightRecorder"] = flightFile;
+            }
+
+            // Swarm metrics, one array per column
+            nlohmann::json metrics = {};
+            metrics["decimation"] = MetricsSampler::getSettings().decimation;
+            metrics["dropped"] = MetricsSampler::getNumDropped();
+            for (unsigned c = 0; c < MetricsSampler::NUM_COLUMNS; c++) {
+                std::vector<float> values(MetricsSampler::getNumSamples());
+                for (size_t i = 0; i < values.size(); i++)
+                    values[i] = MetricsSampler::getValue(MetricsSampler::Column(c), i);
+                metrics[MetricsSampler::columnNames[c]] = values;
+            }
+            _experimentResults["repetitions"].back()["metrics"] = metrics;
+
+            // Sub-goal chains between the object and the goal
+            ChainAnalysis::Report chain = ChainAnalysis::getReport();
+            nlohmann::json subGoalChain = {};
+            if (!std::isnan(chain.firstChainTime))
+                subGoalChain["firstChainTime"] = chain.firstChainTime;
+            subGoalChain["breakages"] = chain.numBreakages;
+            subGoalChain["maxLength"] = chain.maxLength;
+            subGoalChain["meanLength"] = chain.meanLength;
+            subGoalChain["connectedTime"] = chain.connectedTime;
+            _experimentResults["repetitions"].back()["subGoalChain"] = subGoalChain;
+
+            nlohmann::json determinism = finishStateHash();
+            if (!determinism.empty())
+                _experimentResults["repetitions"].back()["determinism"] = determinism;
+
+            std::string replayFile = writeReplay();
+            if (!replayFile.empty())
+                _experimentResults["repetitions"].back()["replay"] = replayFile;
+
+            // JSON log performance
+            Telemetry::Report report = Telemetry::getReport();
+            const uint64_t numSteps = std::lround(atta::Config::getTime() / atta::Config::getDt());
+            nlohmann::json performance = {};
+            performance["wallTime"] = report.wallTime;
+            performance["steps"] = numSteps;
+            performance["stepsPerSecond"] = report.wallTime > 0.0 ? numSteps / report.wallTime : 0.0;
+            performance["peakRssKb"] = Telemetry::getPeakRssKb();
+            performance["maxLoopTime"] = report.maxLoopTime;
+            performance["loopTimeStd"] = report.loopTimeStd;
+            performance["metricsSamplerTime"] = MetricsSampler::getWallTime();
+            performance["stages"] = {};
+            for (unsigned i = 0; i < Telemetry::NUM_STAGES; i++)
+                performance["stages"][Telemetry::stageNames[i]] = report.stageTime[i];
+            performance["allocations"] = {};
+            for (unsigned i = 0; i < AllocCounter::NUM_SUBSYSTEMS; i++) {
+                AllocCounter::Report allocs = AllocCounter::getReport(AllocCounter::Subsystem(i));
+                performance["allocations"][AllocCounter::subsystemNames[i]] = {
+                    {"total", allocs.total}, {"steadyState", allocs.steadyState}, {"maxPerStep", allocs.maxPerStep}};
+            }
+            Lod::Report lod = Lod::getReport();
+            performance["lod"] = {{"ticks", lod.ticks}, {"throttledTicks", lod.throttledTicks}, {"levelTicks", {}}, {"throttledTicksPerRobot", {}}};
+            for (unsigned i = 0; i < Lod::NUM_LEVELS; i++)
+                performance["lod"]["levelTicks"][Lod::levelNames[i]] = lod.levelTicks[i];
+            for (cmp::Entity pusher : cmp::getFactory(pusherProto)->getClones())
+                performance["lod"]["throttledTicksPerRobot"].push_back(Lod::getReport(pusher).throttledTicks);
+            // The pusher control loop should not allocate after the warm-up steps. Without the heap hook only the allocations
+            // through the subsystem resources are counted
+            performance["heapHook"] = AllocCounter::isHeapHookInstalled();
+            performance["allocationFree"] = AllocCounter::isSteadyStateAllocationFree();
+            if (!performance["allocationFree"])
+                LOG_WARN("ProjectScript", "Pusher control loop allocated memory in steady state");
+            _experimentResults["repetitions"].back()["performance"] = performance;
 
             // Stop simulation
             evt::SimulationStop e;
@@ -75,11 +232,39 @@ void ProjectScript::runExperiments() {
 
             // Advance repetition
             _currentRepetition++;
-            if (_currentRepetition == exp.numRepetitions) {
+            bool finished = _currentRepetition == exp.numRepetitions;
+            if (_adaptiveRepetitions) {
+                ExperimentStats::StoppingRule rule = gStoppingRule;
+                rule.maxRepetitions = exp.numRepetitions;
+                std::vector<float> successTimes;
+                for (const nlohmann::json& rep : _experimentResults["repetitions"])
+                    if (rep["success"])
+                        successTimes.push_back(rep["time"]);
+                std::string reason;
+                finished = ExperimentStats::shouldStop(rule, _currentRepetition, successTimes, reason);
+                if (finished) {
+                    _experimentResults["config"]["numRepetitions"] = _currentRepetition;
+                    _experimentResults["config"]["stoppingRule"]["reason"] = reason;
+                }
+            }
+            if (finished && _batchJob) {
+                // Only the outcome is needed by the optimizer
+                for (nlohmann::json& rep : _experimentResults["repetitions"]) {
+                    rep.erase("path");
+                    rep.erase("metrics");
+                }
+                _batchResults.push_back(_experimentResults);
+                _experimentResults = {};
+                _currentExperiment++;
+                _currentRepetition = 0;
+                if (_currentExperiment == experiments.size())
+                    finishBatchJob();
+            } else if (finished) {
                 fs::create_directory("experiments");
                 fs::path file = fs::path("experiments") /
                                 std::string(exp.initialPos + "_init-" + exp.map + "-" + exp.script + "-" + std::to_string(exp.numRobots) +
-                                            "_robots-" + exp.object + "-" + std::to_string(exp.numRepetitions) + "_rep.json");
+                                            "_robots-" + exp.object + (exp.numTasks > 1 ? "-" + std::to_string(exp.numTasks) + "_tasks" : "") +
+                                            "-" + std::to_string(_currentRepetition) + "_rep.json");
                 std::ofstream out(file);
                 LOG_INFO("ProjectScript", "Experiment [w]$0[] saved to [w]$1[]", file.stem().string(), fs::absolute(file));
                 out << _experimentResults;
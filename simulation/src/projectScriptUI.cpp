@@ -8,18 +8,26 @@ void ProjectScript::uiControl() {
     ImGui::Text("Control");
 
     //----- Select map -----//
-    static const char* optionsMap[] = {"reference", "middle", "corner", "2-corners"};
+    // Paper maps and maps directory files
+    std::vector<const char*> optionsMap;
     int selectedMap = 0;
-    for (int i = 0; i < 4; i++)
-        if (_currentMap == std::string(optionsMap[i])) {
-            selectedMap = i;
-            break;
-        }
+    for (const auto& [name, map] : maps) {
+        if (_currentMap == name)
+            selectedMap = optionsMap.size();
+        optionsMap.push_back(name.c_str());
+    }
 
     ImGui::SetNextItemWidth(120.0f);
-    if (ImGui::Combo("Map##ComboMap", &selectedMap, optionsMap, 4)) {
+    if (ImGui::Combo("Map##ComboMap", &selectedMap, optionsMap.data(), optionsMap.size())) {
         selectMap(optionsMap[selectedMap]);
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Reload##ReloadMaps")) {
+        loadMaps();
+        selectMap(_currentMap);
+    }
+    if (ImGui::Checkbox("Merge colinear walls", &_mergeWalls))
+        selectMap(_currentMap);
 
     //----- Select object -----//
     static const char* optionsObject[] = {"square", "rectangle", "circle", "triangle", "plus", "H", "L"};
@@ -34,6 +42,13 @@ void ProjectScript::uiControl() {
     if (ImGui::Combo("Object##ComboObject", &selectedObject, optionsObject, 7)) {
         selectObject(optionsObject[selectedObject]);
     }
+    if (atta::Config::getState() == atta::Config::State::IDLE) {
+        int numTasks = _numTasks;
+        ImGui::SetNextItemWidth(120.0f);
+        if (ImGui::SliderInt("Objects/goals", &numTasks, 1, maxTasks))
+            setNumTasks(numTasks);
+    } else
+        ImGui::Text("Objects/goals: %d", _numTasks);
 
     //----- Select script -----//
     static const char* optionsScript[] = {"Chen et al.", "Proposed", "Teleoperated"};
@@ -67,6 +82,30 @@ void ProjectScript::uiControl() {
     //----- Randomize pusher -----//
     if (ImGui::Button("Randomize pushers"))
         randomizePushers(_currentInitialPos);
+
+    //----- Controller settings -----//
+    ImGui::Checkbox("Frame-synchronous control", &PusherCommon::getSettings().frameSynchronous);
+    if (PusherCommon::getSettings().frameSynchronous) {
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::InputFloat("Infrared change tolerance (m)", &PusherCommon::getSettings().irTolerance, 0.0f, 0.0f, "%.4f");
+        PusherCommon::getSettings().irTolerance = std::max(PusherCommon::getSettings().irTolerance, 0.0f);
+    }
+    ImGui::Checkbox("Batched actuation", &PusherCommon::getSettings().batchedActuation);
+    ImGui::Checkbox("Staggered camera capture", &PusherCommon::getSettings().staggeredCapture);
+    ImGui::Checkbox("Control-rate level of detail", &Lod::getSettings().enabled);
+    if (atta::Config::getState() == atta::Config::State::IDLE) {
+        bool lightweight = _lightweightPushers;
+        if (ImGui::Checkbox("Lightweight pushers", &lightweight))
+            setLightweightPushers(lightweight);
+    } else
+        ImGui::Text("Lightweight pushers: %s", _lightweightPushers ? "on" : "off");
+
+    //----- Debug drawing -----//
+    ImGui::Checkbox("Draw object path", &_drawPath);
+    ImGui::Checkbox("Draw direction lines", &_drawDirections);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputFloat("Drawing rate (Hz, 0: every step)", &_drawRate);
+    _drawRate = std::max(_drawRate, 0.0f);
 }
 
 void ProjectScript::uiExperiment() {
@@ -85,6 +124,7 @@ void ProjectScript::uiExperiment() {
             _experimentResults["config"] = {};
             _experimentResults["repetitions"] = {};
         }
+        ImGui::Checkbox("Adaptive repetitions", &_adaptiveRepetitions);
     } else {
         if (ImGui::Button("Stop experiments")) {
             if (atta::Config::getState() != atta::Config::State::IDLE) {
@@ -101,12 +141,252 @@ void ProjectScript::uiExperiment() {
             ImGui::Text(" - Num robots: %d", experiments[_currentExperiment].numRobots);
             ImGui::Text(" - Map: %s", experiments[_currentExperiment].map.c_str());
             ImGui::Text(" - Object: %s", experiments[_currentExperiment].object.c_str());
+            ImGui::Text(" - Objects/goals: %d", experiments[_currentExperiment].numTasks);
             ImGui::Text(" - Inital Pos: %s", experiments[_currentExperiment].initialPos.c_str());
             ImGui::Text(" - Script: %s", experiments[_currentExperiment].script.c_str());
         }
     }
 }
 
+void ProjectScript::uiTrace() {
+    ImGui::Text("Trace");
+
+    bool changed = ImGui::Checkbox("Record trace", &_traceEnabled);
+    ImGui::SetNextItemWidth(120.0f);
+    changed |= ImGui::InputInt("First step##TraceFirstStep", &_traceFirstStep);
+    ImGui::SetNextItemWidth(120.0f);
+    changed |= ImGui::InputInt("Last step##TraceLastStep", &_traceLastStep);
+    _traceFirstStep = std::max(_traceFirstStep, 0);
+    _traceLastStep = std::max(_traceLastStep, _traceFirstStep);
+
+    if (changed)
+        Trace::configure(_traceEnabled, _traceFirstStep, _traceLastStep);
+}
+
+void ProjectScript::uiFlightRecorder() {
+    ImGui::Text("Flight recorder");
+
+    FlightRecorder::Settings& settings = FlightRecorder::getSettings();
+    ImGui::Checkbox("Record last seconds", &settings.enabled);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputFloat("Seconds##FlightRecorderSeconds", &settings.seconds);
+    settings.seconds = std::max(settings.seconds, 0.1f);
+    ImGui::Checkbox("Dump when object stalls", &settings.dumpOnStall);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputFloat("Stall time##FlightRecorderStallTime", &settings.stallTime);
+    settings.stallTime = std::max(settings.stallTime, 1.0f);
+
+    if (atta::Config::getState() != atta::Config::State::IDLE && ImGui::Button("Dump now"))
+        dumpFlightRecorder("manual");
+}
+
+void ProjectScript::uiMetrics() {
+    ImGui::Text("Swarm metrics");
+
+    MetricsSampler::Settings& settings = MetricsSampler::getSettings();
+    ImGui::Checkbox("Sample swarm metrics", &settings.enabled);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputInt("Steps per sample##MetricsDecimation", &settings.decimation);
+    settings.decimation = std::max(settings.decimation, 1);
+
+    if (atta::Config::getState() != atta::Config::State::IDLE && MetricsSampler::getNumSamples() > 0) {
+        size_t last = MetricsSampler::getNumSamples() - 1;
+        ImGui::Text("%zu samples (%zu dropped)", MetricsSampler::getNumSamples(), MetricsSampler::getNumDropped());
+        for (unsigned c = MetricsSampler::RANDOM_WALK; c <= MetricsSampler::BE_A_GOAL; c++)
+            ImGui::Text(" - %s: %.1f", MetricsSampler::columnNames[c], MetricsSampler::getValue(MetricsSampler::Column(c), last));
+        double wallTime = Telemetry::getReport().wallTime;
+        ImGui::Text("Overhead: %.3f%%", wallTime > 0.0 ? MetricsSampler::getWallTime() / wallTime * 100.0 : 0.0);
+    }
+
+    ImGui::Checkbox("Detect sub-goal chains", &ChainAnalysis::getSettings().enabled);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputFloat("View range##ChainViewRange", &ChainAnalysis::getSettings().viewRange);
+    if (atta::Config::getState() != atta::Config::State::IDLE) {
+        ChainAnalysis::Report chain = ChainAnalysis::getReport();
+        ImGui::Text("Chain: %s, %u sub-goals (%u breakages)", chain.connected ? "connected" : "disconnected", chain.currentLength,
+                    chain.numBreakages);
+    }
+}
+
+void ProjectScript::uiReplay() {
+    ImGui::Text("Replay");
+    ImGui::Checkbox("Record replays", &Replay::getSettings().enabled);
+
+    static char file[256] = "experiments/";
+    ImGui::InputText("File##ReplayFile", file, sizeof(file));
+    if (ImGui::Button("Load")) {
+        if (_replay.load(file)) {
+            clearObjectPath();
+            _replayTime = 0.0f;
+            _replayPlaying = false;
+            LOG_INFO("ProjectScript", "Replay loaded from [w]$0[] ($1 frames)", file, _replay.getNumFrames());
+        } else
+            LOG_WARN("ProjectScript", "Failed to load replay from [w]$0", file);
+    }
+    if (_replay.getNumFrames() == 0)
+        return;
+    ImGui::SameLine();
+    if (ImGui::Button("Close")) {
+        _replay.clear();
+        return;
+    }
+
+    // Playback
+    ImGui::Text("%s - %s (%d robots)", _replay.getInfo().map.c_str(), _replay.getInfo().object.c_str(), _replay.getInfo().numRobots);
+    if (ImGui::Button(_replayPlaying ? "Pause" : "Play")) {
+        _replayPlaying = !_replayPlaying;
+        _replayLastWallTime = Telemetry::now();
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Speed", &_replaySpeed, 0.1f, 32.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+    const float duration = (_replay.getNumFrames() - 1) * _replay.getInfo().dt;
+    ImGui::SliderFloat("Time", &_replayTime, 0.0f, duration, "%.2fs");
+}
+
+void ProjectScript::drawerReplay() {
+    gfx::Drawer::clear("replay");
+    if (atta::Config::getState() != atta::Config::State::IDLE || _replay.getNumFrames() == 0)
+        return;
+
+    // Advance playback
+    const Replay::Info& info = _replay.getInfo();
+    const float duration = (_replay.getNumFrames() - 1) * info.dt;
+    if (_replayPlaying) {
+        uint64_t now = Telemetry::now();
+        _replayTime += (now - _replayLastWallTime) * 1e-9f * _replaySpeed;
+        _replayLastWallTime = now;
+        if (_replayTime >= duration) {
+            _replayTime = duration;
+            _replayPlaying = false;
+        }
+    }
+    _replayTime = std::clamp(_replayTime, 0.0f, duration);
+
+    static Replay::FrameHeader frame;
+    static std::vector<Replay::RobotSample> samples;
+    const uint32_t idx = std::min<uint32_t>(std::lround(_replayTime / info.dt), _replay.getNumFrames() - 1);
+    if (!_replay.getFrame(idx, frame, samples))
+        return;
+
+    auto toVec4 = [](Color c) { return atta::vec4(c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, 1.0f); };
+    auto drawCircle = [](atta::vec2 center, float radius, atta::vec4 color) {
+        const int numSegments = 16;
+        gfx::Drawer::Line line;
+        line.c0 = line.c1 = color;
+        for (int i = 0; i < numSegments; i++) {
+            float a0 = 2 * M_PI * i / numSegments;
+            float a1 = 2 * M_PI * (i + 1) / numSegments;
+            line.p0 = atta::vec3(center.x + radius * std::cos(a0), center.y + radius * std::sin(a0), 0.1f);
+            line.p1 = atta::vec3(center.x + radius * std::cos(a1), center.y + radius * std::sin(a1), 0.1f);
+            gfx::Drawer::add(line, "replay");
+        }
+    };
+    auto drawDirection = [](atta::vec2 pos, float angle, float length, atta::vec4 color) {
+        gfx::Drawer::Line line;
+        line.p0 = atta::vec3(pos, 0.1f);
+        line.p1 = line.p0 + length * atta::vec3(std::cos(angle), std::sin(angle), 0);
+        line.c0 = line.c1 = color;
+        gfx::Drawer::add(line, "replay");
+    };
+
+    // Goal and object
+    if (info.goalRadius > 0.0f)
+        drawCircle(atta::vec2(info.goalX, info.goalY), info.goalRadius, toVec4(goalColor));
+    const atta::vec2 objPos(frame.objectX, frame.objectY);
+    const float objRadius = info.objectRadius > 0.0f ? info.objectRadius : 0.1f;
+    drawCircle(objPos, objRadius, toVec4(objectColor));
+    drawDirection(objPos, frame.objectAngle, objRadius, toVec4(objectColor));
+
+    // Object path until the current frame
+    const std::vector<atta::vec2>& path = _replay.getObjectPath();
+    for (uint32_t i = 0; i < idx; i++) {
+        gfx::Drawer::Line line;
+        line.p0 = atta::vec3(path[i], 0.1f);
+        line.p1 = atta::vec3(path[i + 1], 0.1f);
+        line.c0 = line.c1 = toVec4(objectColor);
+        gfx::Drawer::add(line, "replay");
+    }
+
+    // Pushers with their heading and direction lines
+    const float length = 0.1f;
+    for (const Replay::RobotSample& s : samples) {
+        const atta::vec2 pos(s.x, s.y);
+        atta::vec4 color = s.state == PusherComponent::BE_A_GOAL ? toVec4(goalColor) : toVec4(pusherColor);
+        drawCircle(pos, info.pusherRadius, color);
+        drawDirection(pos, s.angle, info.pusherRadius, color);
+        if (!std::isnan(s.goalDirection))
+            drawDirection(pos, s.angle - s.goalDirection, length, toVec4(goalColor));
+        if (!std::isnan(s.objectDirection))
+            drawDirection(pos, s.angle - s.objectDirection, length, toVec4(objectColor));
+        if (!std::isnan(s.pushDirection))
+            drawDirection(pos, s.angle - s.pushDirection, length, toVec4(pusherColor));
+    }
+}
+
+void ProjectScript::uiDeterminism() {
+    ImGui::Text("Determinism");
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputInt("Seed", &_seed);
+    _seed = std::max(_seed, 0);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::Combo("State hash", &_stateHashMode, StateHash::modeNames, StateHash::NUM_MODES);
+}
+
+void ProjectScript::uiMapGenerator() {
+    ImGui::Text("Map generator");
+    MapGenerator::Params& p = _mapGeneratorParams;
+    int seed = p.seed;
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputInt("Seed##MapGeneratorSeed", &seed);
+    p.seed = std::max(seed, 0);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Arena size", &p.arenaSize, 3.0f, 300.0f, "%.1f m", ImGuiSliderFlags_Logarithmic);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Wall density", &p.wallDensity, 0.0f, 0.4f, "%.2f");
+    int maxWalls = p.maxWalls;
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputInt("Max walls", &maxWalls);
+    p.maxWalls = std::max(maxWalls, 0);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Corridor width", &p.corridorWidth, 0.5f, 5.0f, "%.2f m");
+    ImGui::Checkbox("Tiled walls", &p.tiledWalls);
+
+    if (ImGui::Button("Generate")) {
+        // Saved to the maps directory so it can be used in experiments
+        std::string name = "generated-" + std::to_string(int(p.arenaSize)) + "m" + (p.tiledWalls ? "-tiled" : "") + "-seed_" + std::to_string(p.seed);
+        saveMap(name, MapGenerator::generate(p));
+        selectMap(name);
+        LOG_INFO("ProjectScript", "Generated map [w]$0[] with [w]$1[] walls", name, maps[name].walls.size());
+    }
+}
+
+void ProjectScript::uiControllerParams() {
+    ImGui::Text("Controller parameters");
+    ControllerParams::Params& params = PusherCommon::getParams();
+    for (const ControllerParams::Info& info : ControllerParams::infos) {
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::SliderFloat(info.name, &(params.*info.member), info.min, info.max, "%.3f");
+    }
+    if (ImGui::Button("Reset##ControllerParams"))
+        params = {};
+    ImGui::SameLine();
+    if (ImGui::Button("Load##ControllerParams")) {
+        std::ifstream in(controllerParamsFile);
+        nlohmann::json json = nlohmann::json::parse(in, nullptr, false);
+        if (json.is_discarded())
+            LOG_WARN("ProjectScript", "Could not load controller parameters from [w]$0", fs::absolute(controllerParamsFile));
+        else
+            params = ControllerParams::fromJson(json);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save##ControllerParams")) {
+        std::ofstream out(controllerParamsFile);
+        out << ControllerParams::toJson(params).dump(4);
+        LOG_INFO("ProjectScript", "Controller parameters saved to [w]$0", fs::absolute(controllerParamsFile));
+    }
+}
+
 void ProjectScript::uiPusherInspector() {
     if (atta::Config::getState() != atta::Config::State::IDLE) {
         cmp::Entity selected = cmp::getSelectedEntity();
@@ -114,30 +394,46 @@ void ProjectScript::uiPusherInspector() {
         if (factory->isRootClone(selected)) {
             ImGui::Text("Inspector");
             cmp::Entity clone = selected;
-            ImGui::Text("Pusher %d", clone.getId());
+            ImGui::Text("Pusher %d (task %u)", clone.getId(), clone.get<PusherComponent>()->task());
 
-            // Get camera components
-            cmp::Entity cameras = clone.getChild(0);
-            std::array<cmp::CameraSensor*, 4> cams;
-            for (unsigned i = 0; i < cams.size(); i++)
-                cams[i] = cameras.getChild(i).get<cmp::CameraSensor>();
-
-            // Get sensor module camera info
-            std::vector<sns::CameraInfo>& snsCams = sns::getCameraInfos();
-
-            // Show camera images
             ImVec2 cursor = ImGui::GetCursorScreenPos(); // Image cursor position
-            for (auto cam : cams)
-                if (cam->captureTime >= 0.0f)
-                    for (uint32_t i = 0; i < snsCams.size(); i++)
-                        if (snsCams[i].component == cam) {
-                            ImGui::Image(snsCams[i].renderer->getImGuiTexture(), ImVec2(75, 75));
-                            if (cam != cams.back())
-                                ImGui::SameLine(0.0f, 0.0f);
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            if (const PusherSensorsComponent* sensors = clone.get<PusherSensorsComponent>()) {
+                // Show panorama with the camera colors
+                constexpr unsigned w = PusherSensorsComponent::panoramaWidth;
+                constexpr unsigned h = PusherSensorsComponent::panoramaHeight;
+                const ImVec2 pixelSize(300.0f / w, 75.0f / h);
+                if (sensors->captureTime >= 0.0f)
+                    for (unsigned y = 0; y < h; y++)
+                        for (unsigned x = 0; x < w; x++) {
+                            const uint8_t pixel = sensors->panorama[y * w + x];
+                            const Color c = pixel == PusherSensorsComponent::WALL ? Color(128, 128, 128) : PusherCommon::panoramaColor(pixel);
+                            ImVec2 p0(cursor.x + x * pixelSize.x, cursor.y + y * pixelSize.y);
+                            drawList->AddRectFilled(p0, ImVec2(p0.x + pixelSize.x, p0.y + pixelSize.y), ImColor(c.r, c.g, c.b));
                         }
+                ImGui::Dummy(ImVec2(300, 75));
+            } else {
+                // Get camera components
+                cmp::Entity cameras = clone.getChild(0);
+                std::array<cmp::CameraSensor*, 4> cams;
+                for (unsigned i = 0; i < cams.size(); i++)
+                    cams[i] = cameras.getChild(i).get<cmp::CameraSensor>();
+
+                // Get sensor module camera info
+                std::vector<sns::CameraInfo>& snsCams = sns::getCameraInfos();
+
+                // Show camera images
+                for (auto cam : cams)
+                    if (cam->captureTime >= 0.0f)
+                        for (uint32_t i = 0; i < snsCams.size(); i++)
+                            if (snsCams[i].component == cam) {
+                                ImGui::Image(snsCams[i].renderer->getImGuiTexture(), ImVec2(75, 75));
+                                if (cam != cams.back())
+                                    ImGui::SameLine(0.0f, 0.0f);
+                            }
+            }
 
             // Draw direction lines
-            ImDrawList* drawList = ImGui::GetWindowDrawList();
 
             PusherComponent* pusher = clone.get<PusherComponent>();
             constexpr int gap = 5;
@@ -159,52 +455,76 @@ void ProjectScript::uiPusherInspector() {
 }
 
 void ProjectScript::drawerPathLines() {
-    gfx::Drawer::clear("path");
-    for (int i = 0; i < int(_objectPath.size()) - 1; i++) {
+    // The path only grows until it is cleared, so only the new segments are added
+    if (!_drawPath) {
+        if (_numPathPointsDrawn > 0)
+            gfx::Drawer::clear("path");
+        _numPathPointsDrawn = 0;
+        return;
+    }
+    for (size_t i = std::max<size_t>(_numPathPointsDrawn, 1); i < _objectPath.size(); i++) {
         gfx::Drawer::Line line;
-        line.p0 = atta::vec3(_objectPath[i], 0.1f);
-        line.p1 = atta::vec3(_objectPath[i + 1], 0.1f);
+        line.p0 = atta::vec3(_objectPath[i - 1], 0.1f);
+        line.p1 = atta::vec3(_objectPath[i], 0.1f);
         line.c0 = line.c1 = {objectColor.r / 255.0f, objectColor.g / 255.0f, objectColor.b / 255.0f, 1};
         gfx::Drawer::add(line, "path");
     }
+    _numPathPointsDrawn = _objectPath.size();
 }
 
+void ProjectScript::clearObjectPath() {
+    _objectPath.clear();
+    if (_numPathPointsDrawn > 0)
+        gfx::Drawer::clear("path");
+    _numPathPointsDrawn = 0;
+}
+
+// Direction lines of each pusher (goal, object and push). Hidden lines have zero length. The drawer has no in-place update,
+// so the group is rebuilt when a line changed, at most directionsRate times per second of wall time (the lines change on
+// every step while the pushers move)
+constexpr float directionsRate = 10.0f;
+
 void ProjectScript::drawerPusherLines() {
-    // Draw direction lines
-    gfx::Drawer::clear("directions");
-    if (atta::Config::getState() != atta::Config::State::IDLE) {
-        for (cmp::Entity clone : cmp::getFactory(pusherProto)->getClones()) {
-            auto t = clone.get<cmp::Transform>();
-            auto p = clone.get<PusherComponent>();
-            float ang = 0.0f;
-            const float length = 0.1f;
-
-            gfx::Drawer::Line line;
-            line.p0 = t->position;
-
-            // Draw goal line
-            if (!std::isnan(p->goalDirection)) {
-                ang = t->orientation.get2DAngle() - p->goalDirection;
-                line.p1 = line.p0 + length * atta::vec3(std::cos(ang), std::sin(ang), 0);
-                line.c0 = line.c1 = {goalColor.r / 255.0f, goalColor.g / 255.0f, goalColor.b / 255.0f, 1};
-                gfx::Drawer::add(line, "directions");
-            }
+    if (!_drawDirections || atta::Config::getState() == atta::Config::State::IDLE) {
+        if (!_directionLines.empty()) {
+            gfx::Drawer::clear("directions");
+            _directionLines.clear();
+        }
+        return;
+    }
 
-            // Draw object line
-            if (!std::isnan(p->objectDirection)) {
-                ang = t->orientation.get2DAngle() - p->objectDirection;
-                line.p1 = line.p0 + length * atta::vec3(std::cos(ang), std::sin(ang), 0);
-                line.c0 = line.c1 = {objectColor.r / 255.0f, objectColor.g / 255.0f, objectColor.b / 255.0f, 1};
-                gfx::Drawer::add(line, "directions");
-            }
+    // Throttle the rebuilds
+    const uint64_t now = Telemetry::now();
+    if (!_directionLines.empty() && now - _lastDirectionsTime < uint64_t(1e9f / directionsRate))
+        return;
 
-            // Draw push line
-            if (!std::isnan(p->pushDirection)) {
-                ang = t->orientation.get2DAngle() - p->pushDirection;
-                line.p1 = line.p0 + length * atta::vec3(std::cos(ang), std::sin(ang), 0);
-                line.c0 = line.c1 = {pusherColor.r / 255.0f, pusherColor.g / 255.0f, pusherColor.b / 255.0f, 1};
-                gfx::Drawer::add(line, "directions");
-            }
+    const std::vector<cmp::Entity>& pushers = cmp::getFactory(pusherProto)->getClones();
+    bool changed = _directionLines.size() != pushers.size() * 3;
+    _directionLines.resize(pushers.size() * 3);
+    auto setLine = [&changed](gfx::Drawer::Line& line, atta::vec3 p0, float ang, Color c) {
+        const float length = 0.1f;
+        atta::vec3 p1 = std::isnan(ang) ? p0 : p0 + length * atta::vec3(std::cos(ang), std::sin(ang), 0);
+        if (line.p0.x != p0.x || line.p0.y != p0.y || line.p1.x != p1.x || line.p1.y != p1.y) {
+            line.p0 = p0;
+            line.p1 = p1;
+            line.c0 = line.c1 = {c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, 1};
+            changed = true;
         }
+    };
+    for (size_t i = 0; i < pushers.size(); i++) {
+        auto t = pushers[i].get<cmp::Transform>();
+        auto p = pushers[i].get<PusherComponent>();
+        const float heading = t->orientation.get2DAngle();
+        setLine(_directionLines[3 * i + 0], t->position, heading - p->goalDirection, goalColors[p->task()]);
+        setLine(_directionLines[3 * i + 1], t->position, heading - p->objectDirection, objectColors[p->task()]);
+        setLine(_directionLines[3 * i + 2], t->position, heading - p->pushDirection, pusherColor);
     }
+    if (!changed)
+        return;
+
+    _lastDirectionsTime = now;
+    gfx::Drawer::clear("directions");
+    for (const gfx::Drawer::Line& line : _directionLines)
+        if (line.p0.x != line.p1.x || line.p0.y != line.p1.y)
+            gfx::Drawer::add(line, "directions");
 }
@@ -4,8 +4,98 @@
 // Date: 2023-02-08
 //--------------------------------------------------
 #include "pusherCommon.h"
+#include "chunkedStore.h"
+#include "controlKernels.h"
+#include "telemetry.h"
+#include "traceRecorder.h"
 #include <atta/component/components/rigidBody2D.h>
 #include <atta/component/components/transform.h>
+#include <cassert>
+
+PusherCommon::Settings settings;
+ControllerParams::Params params;
+ChunkedStore<PusherCommon::Scratch> scratches(AllocCounter::getResource(AllocCounter::CONTROL));
+ChunkedStore<PusherCommon::Command> commands(AllocCounter::getResource(AllocCounter::CONTROL));
+
+// Batched actuation buffers
+std::pmr::memory_resource* batchResource = AllocCounter::getResource(AllocCounter::CONTROL);
+std::pmr::vector<cmp::Entity> batchEntities{batchResource};
+std::pmr::vector<float> batchDirX{batchResource}, batchDirY{batchResource}, batchHeading{batchResource};
+std::pmr::vector<float> batchLinVel{batchResource}, batchAngVel{batchResource}, batchVelX{batchResource}, batchVelY{batchResource};
+
+PusherCommon::Settings& PusherCommon::getSettings() { return settings; }
+
+ControllerParams::Params& PusherCommon::getParams() { return params; }
+
+PusherCommon::Scratch& PusherCommon::getScratch(cmp::Entity entity) { return scratches[entity.getId()]; }
+
+void PusherCommon::reserveScratch(cmp::Entity entity, unsigned rowSize) {
+    getScratch(entity).intervals.reserve(rowSize / 2 + 1); // Worst case of alternating pixels
+}
+
+PusherCommon::Command& PusherCommon::getCommand(cmp::Entity entity) { return commands[entity.getId()]; }
+
+void setVelocities(cmp::Entity entity, float angVel, atta::vec2 vel) {
+    auto r = entity.get<cmp::RigidBody2D>();
+    r->setLinearVelocity(vel);
+    r->setAngularVelocity(angVel);
+}
+
+void PusherCommon::applyCommand(cmp::Entity entity, Command& command) {
+    if (settings.batchedActuation) {
+        if (!command.queued) {
+            batchEntities.push_back(entity);
+            command.queued = true;
+        }
+        return;
+    }
+
+    if (command.linVel == 0.0f && command.angVel == 0.0f) {
+        setVelocities(entity, 0.0f, atta::vec2(0.0f));
+        return;
+    }
+    float angle = entity.get<cmp::Transform>()->orientation.get2DAngle();
+    setVelocities(entity, command.angVel, atta::vec2(command.linVel * cos(angle), command.linVel * sin(angle)));
+}
+
+void PusherCommon::flushCommands() {
+    AllocCounter::Scope allocScope(AllocCounter::CONTROL);
+    const size_t n = batchEntities.size();
+    batchDirX.resize(n);
+    batchDirY.resize(n);
+    batchHeading.resize(n);
+    batchLinVel.resize(n);
+    batchAngVel.resize(n);
+    batchVelX.resize(n);
+    batchVelY.resize(n);
+
+    // Gather
+    for (size_t i = 0; i < n; i++) {
+        const Command& command = getCommand(batchEntities[i]);
+        batchDirX[i] = command.direction.x;
+        batchDirY[i] = command.direction.y;
+        batchHeading[i] = batchEntities[i].get<cmp::Transform>()->orientation.get2DAngle();
+    }
+
+    ControlKernels::computeDriveBatch(n, batchDirX.data(), batchDirY.data(), batchHeading.data(), batchLinVel.data(), batchAngVel.data(),
+                                      batchVelX.data(), batchVelY.data());
+
+    // Scatter
+    for (size_t i = 0; i < n; i++) {
+        Command& command = getCommand(batchEntities[i]);
+#ifndef NDEBUG
+        // Batched kinematics must match the scalar version
+        float linVel, angVel;
+        computeDrive(command.direction, linVel, angVel);
+        assert(std::abs(linVel - batchLinVel[i]) < 1e-4f && std::abs(angVel - batchAngVel[i]) < 1e-4f);
+#endif
+        command.linVel = batchLinVel[i];
+        command.angVel = batchAngVel[i];
+        command.queued = false;
+        setVelocities(batchEntities[i], batchAngVel[i], atta::vec2(batchVelX[i], batchVelY[i]));
+    }
+    batchEntities.clear();
+}
 
 void PusherCommon::changeState(PusherComponent* pusher, PusherComponent::State state) {
     // Don't reset the timer if changed between MOVE_AROUND_OBJECT and PUSH_OBJECT
@@ -18,16 +108,18 @@ void PusherCommon::changeState(PusherComponent* pusher, PusherComponent::State s
 }
 
 void PusherCommon::move(cmp::Entity entity, atta::vec2 direction) {
-    constexpr float wheelD = 0.06f; // Wheel distance
-    constexpr float wheelR = 0.01f; // Wheel radius
-    constexpr float maxPwr = 50.0f; // Motor maximum power (max 0.5m/s)
-
-    auto r = entity.get<cmp::RigidBody2D>();
+    Command& command = getCommand(entity);
+    command.valid = true;
+    command.direction = direction;
+    if (!settings.batchedActuation)
+        computeDrive(direction, command.linVel, command.angVel);
+    applyCommand(entity, command);
+}
 
+void PusherCommon::computeDrive(atta::vec2 direction, float& linVel, float& angVel) {
     // If break motors
     if (direction.x == 0.0f && direction.y == 0.0f) {
-        r->setLinearVelocity(atta::vec2(0.0f));
-        r->setAngularVelocity(0.0f);
+        linVel = angVel = 0.0f;
         return;
     }
 
@@ -36,16 +128,11 @@ void PusherCommon::move(cmp::Entity entity, atta::vec2 direction) {
     float dirAngle = atan2(direction.y, direction.x);                             // Direction angle
     atta::vec2 pwr(cos(dirAngle) - sin(dirAngle), cos(dirAngle) + sin(dirAngle)); // Power
     pwr.normalize();
-    pwr *= maxPwr;
+    pwr *= ControlKernels::maxPwr;
 
     // Calculate linear/angular velocities (differential drive robot)
-    float linVel = wheelR / 2.0f * (pwr.x + pwr.y);
-    float angVel = wheelR / wheelD * (pwr.x - pwr.y);
-
-    // Apply velocities
-    float angle = entity.get<cmp::Transform>()->orientation.get2DAngle();
-    r->setLinearVelocity(atta::vec2(linVel * cos(angle), linVel * sin(angle)));
-    r->setAngularVelocity(angVel);
+    linVel = ControlKernels::wheelR / 2.0f * (pwr.x + pwr.y);
+    angVel = ControlKernels::wheelR / ControlKernels::wheelD * (pwr.x - pwr.y);
 }
 
 atta::vec2 PusherCommon::dirToVec(float dir) { return {std::cos(dir), std::sin(dir)}; }
@@ -57,236 +144,43 @@ float PusherCommon::distInDirection(const std::array<float, 8>& irs, float dir)
     return irs[idx];
 }
 
-float angleDistance(float a0, float a1) {
-    float dist = a1 > a0 ? (a1 - a0) : (a0 - a1);
-    return dist > M_PI ? 2 * M_PI - dist : dist;
-}
-
-void PusherCommon::randomWalk(cmp::Entity entity, PusherComponent* pusher, float dt, bool isPaperScript) {
-    const float a = 2.0f;
-    const float b = 0.2f;
-    pusher->randomWalkAux += dt * (rand() / float(RAND_MAX) * a * 2 - a); // Add Unif(-a, a)
-
-    // Clip randomWalkAux angle
-    if (pusher->randomWalkAux < -b)
-        pusher->randomWalkAux = -b;
-    if (pusher->randomWalkAux > b)
-        pusher->randomWalkAux = b;
-    PusherCommon::move(entity, PusherCommon::dirToVec(pusher->randomWalkAux));
-
-    if (!isPaperScript) {
-        // If the goal is no longer visible
-        bool noLongerVisible = !pusher->canSeeGoal() && pusher->couldSeeGoal;
-        if (noLongerVisible && pusher->angleGreater90) {
-            PusherCommon::changeState(pusher, PusherComponent::BE_A_GOAL);
-            return;
-        }
-    }
-
-    // Check if it can see
-    bool canSee = pusher->canSeeObject() && (!isPaperScript ? pusher->canSeeGoal() : true);
-    if (canSee)
-        PusherCommon::changeState(pusher, PusherComponent::APPROACH_OBJECT);
-}
-
-void PusherCommon::approachObject(cmp::Entity entity, PusherComponent* pusher, const std::array<float, 8>& irs, bool isPaperScript) {
-    const float minCamDist = 0.15f; // Minimum distance to the object to change state (using Camera)
-    const float minIrDist = 0.1f;   // Minimum distance to the object to change state (using IR)
-    const float minAngle = 0.15f;   // The front angle interval is [-minAngle, minAngle]
-
-    // Check if it can still see
-    bool canSee = pusher->canSeeObject() && (!isPaperScript ? pusher->canSeeGoal() : true);
-    if (!canSee) {
-        PusherCommon::changeState(pusher, PusherComponent::RANDOM_WALK);
-        return;
-    }
-
-    float dir = pusher->objectDirection;
-
-    // Move to object
-    PusherCommon::move(entity, PusherCommon::dirToVec(dir));
-
-    // Check if arrived
-    bool isClose = pusher->objectDistance < minCamDist &&                                   // If distance from camera is small
-                   PusherCommon::distInDirection(irs, pusher->objectDirection) < minIrDist; // And distance from IR is small
-    bool isInFront = (dir < minAngle && dir > -minAngle) || (dir < (-M_PI + minAngle) || dir > (M_PI - minAngle));
-    if (isClose && isInFront) {
-        if (!pusher->canSeeGoal() && pusher->freeSpaceToPush())
-            PusherCommon::changeState(pusher, PusherComponent::PUSH_OBJECT);
-        else
-            PusherCommon::changeState(pusher, PusherComponent::MOVE_AROUND_OBJECT);
-        return;
+bool PusherCommon::irsChanged(const std::array<float, 8>& irs, const std::array<float, 8>& prev, float tolerance) {
+    for (size_t i = 0; i < irs.size(); i++) {
+        if (std::isnan(irs[i]) != std::isnan(prev[i]))
+            return true;
+        if (std::abs(irs[i] - prev[i]) > tolerance)
+            return true;
     }
+    return false;
 }
 
-void PusherCommon::moveAroundObject(cmp::Entity entity, PusherComponent* pusher, const std::array<float, 8>& irs, float dt, bool isPaperScript) {
-    //----- Check lost object -----//
-    if (!pusher->canSeeObject()) {
-        PusherCommon::changeState(pusher, PusherComponent::RANDOM_WALK);
-        return;
-    }
-
-    //----- Check should push -----//
-    if (!pusher->canSeeGoal() && pusher->freeSpaceToPush()) {
-        PusherCommon::changeState(pusher, PusherComponent::PUSH_OBJECT);
-        return;
-    }
-
-    //----- Timeout -----//
-    // If timer reached zero
-    if (pusher->timer >= PusherComponent::pushObjectTimeout) {
-        PusherCommon::changeState(pusher, PusherComponent::RANDOM_WALK);
-        return;
-    }
-
-    //----- Select clockwise/anti-clockwise -----//
-    if (!isPaperScript && pusher->canSeeGoal()) {
-        float diff = pusher->objectDirection - pusher->goalDirection;
-        if (diff >= 2 * M_PI)
-            diff -= 2 * M_PI;
-        if (diff < 0)
-            diff += 2 * M_PI;
-        pusher->clockwise = diff >= M_PI;
-    }
-
-    //----- Parameters -----//
-    atta::vec2 moveVec(1.0f, 0.0f); // Robot move vector (X is to the forward, Y is left)
-    const float minDist = 0.1f;
-    const float maxDist = 0.25f;
-
-    unsigned idxF = pusher->clockwise ? 0 : 4; // Index at the front of the robot
-    if (pusher->objectDirection < 0) {
-        // If robot moving "backward", front sensor is behind
-        idxF = (idxF == 4) ? 0 : 4;
-    }
-
-    //----- Force field -----//
-    atta::vec2 objVec = PusherCommon::dirToVec(pusher->objectDirection);
-
-    // Force to move around the object
-    moveVec = atta::vec2(-objVec.y, objVec.x);
-    if (pusher->clockwise)
-        moveVec *= -1;
-
-    // Force to keep distance from object
-    if (pusher->objectDistance > 0.2 || PusherCommon::distInDirection(irs, pusher->objectDirection) > 0.2)
-        moveVec += objVec;
-
-    //----- Output - move -----//
-    PusherCommon::move(entity, moveVec);
-}
-
-void PusherCommon::pushObject(cmp::Entity entity, PusherComponent* pusher) {
-    // Can't see object anymore
-    if (!pusher->canSeeObject()) {
-        PusherCommon::changeState(pusher, PusherComponent::RANDOM_WALK);
-        return;
-    }
-
-    // Can see goal or no free space to push
-    if (pusher->canSeeGoal() || !pusher->freeSpaceToPush()) {
-        PusherCommon::changeState(pusher, PusherComponent::MOVE_AROUND_OBJECT);
-        return;
-    }
-
-    // Timeout
-    if (pusher->timer >= PusherComponent::pushObjectTimeout) {
-        PusherCommon::changeState(pusher, PusherComponent::RANDOM_WALK);
-        return;
-    }
-
-    // Push
-    PusherCommon::move(entity, PusherCommon::dirToVec(pusher->objectDirection));
+float angleDistance(float a0, float a1) {
+    float dist = a1 > a0 ? (a1 - a0) : (a0 - a1);
+    return dist > M_PI ? 2 * M_PI - dist : dist;
 }
 
-float calcDirection(std::array<cmp::CameraSensor*, 4> cams, unsigned y, Color color) {
-    // Create row of colors
-    std::array<const uint8_t*, 4> images = {cams[0]->getImage(), cams[1]->getImage(), cams[2]->getImage(), cams[3]->getImage()};
-    const unsigned w = cams[0]->width;
-    const unsigned h = cams[0]->height;
-
-    // Initialize row to compute
-    std::vector<Color> row(w * 4);
-    for (unsigned i = 0; i < w * 4; i++) {
-        const uint8_t* img = images[i / w];
-        unsigned idx = (y * w + (i % w)) * 3;
-        Color color(img[idx + 0], img[idx + 1], img[idx + 2]);
-        row[i] = color;
-    }
-
-    // Calculate intervals
-    std::vector<std::pair<int, int>> intervals;
-    int start = -1;
-    int end = -1;
-    for (unsigned i = 0; i < row.size(); i++) {
-        if (row[i] != color) {
-            if (start != end)
-                intervals.push_back({start + 1, end});
-            start = i;
-            end = i;
-        } else
-            end = i;
-    }
-    if (start != end)
-        intervals.push_back({start + 1, end});
-
-    // If could not find color, return NaN
-    if (intervals.empty()) {
+// Direction of the largest interval of a color in row y. The row spans 360 degrees (the four cameras side by side) and
+// pixelAt(x, y) returns the color of a pixel
+template <typename PixelAt>
+float calcDirection(unsigned rowSize, PixelAt pixelAt, unsigned y, Color color, PusherCommon::Scratch& scratch) {
+    // Intervals reserved by reserveScratch for the worst case
+    float dir = ControlKernels::largestIntervalDirection(rowSize, [&](unsigned x) { return pixelAt(x, y) == color; }, scratch.intervals);
+    if (std::isnan(dir))
         LOG_WARN("PusherScript", "No interval found when calculating direction");
-        return NAN;
-    }
-
-    // Merge intervals
-    if (intervals.size() > 1 && intervals.front().first == 0 && intervals.back().second == row.size() - 1) {
-        intervals.front().first = intervals.back().first;
-        intervals.pop_back();
-    }
-
-    // Find largest interval
-    unsigned idxLargest = -1;
-    unsigned sizeLargest = 0;
-    for (unsigned i = 0; i < intervals.size(); i++) {
-        int start = intervals[i].first;
-        int end = intervals[i].second;
-
-        // Calculate size
-        unsigned size = 0;
-        if (start <= end)
-            size = end - start + 1;
-        else
-            size = (row.size() - start) + end + 1;
-
-        // Update largest
-        if (size >= sizeLargest) {
-            idxLargest = i;
-            sizeLargest = size;
-        }
-    }
-
-    // Calculate direction to largest interval
-    auto interval = intervals[idxLargest];
-    // Calculate mean pixel position
-    int pixelPos = (interval.first + sizeLargest / 2) % row.size();
-    // Convert to [0,1]
-    float meanPos = pixelPos / float(row.size());
-    // Convert to [-2, 2] (and rotate so 0.0 is to the front)
-    meanPos = (meanPos * 4 - 0.5);
-    if (meanPos > 2)
-        meanPos = -2 + (meanPos - 2);
-    // Return direction
-    return meanPos * M_PI * 0.5;
+    return dir;
 }
 
-void PusherCommon::processCameras(PusherComponent* pusher, std::array<cmp::CameraSensor*, 4> cams) {
-    PROFILE();
-
+// Extract object/goal directions and distances from a 360 degree image of rowSize x h pixels
+template <typename PixelAt>
+void processImage(cmp::Entity entity, PusherComponent* pusher, float captureTime, unsigned rowSize, unsigned h, PixelAt pixelAt) {
     // If it is not a new image, do not process
-    if (cams[0]->captureTime == pusher->lastFrameTime)
+    PusherComponent::Cold& cold = PusherComponent::cold(entity);
+    if (captureTime == cold.lastFrameTime)
         return;
 
     // Store data about last frame
-    pusher->lastFrameTime = cams[0]->captureTime;
-    pusher->couldSeeGoal = pusher->canSeeGoal();
+    cold.lastFrameTime = captureTime;
+    pusher->setFlag(PusherComponent::COULD_SEE_GOAL, pusher->canSeeGoal());
 
     // Initialize values as default
     pusher->objectDirection = NAN;
@@ -296,49 +190,81 @@ void PusherCommon::processCameras(PusherComponent* pusher, std::array<cmp::Camer
     pusher->pushDirection = NAN;
 
     // If there is no image available yet, don't process
-    if (cams[0]->captureTime < 0.0f)
+    if (captureTime < 0.0f)
         return;
+    Telemetry::markCameraFrame();
 
-    // Process images
-    std::array<const uint8_t*, 4> images = {cams[0]->getImage(), cams[1]->getImage(), cams[2]->getImage(), cams[3]->getImage()};
-    const unsigned w = cams[0]->width;
-    const unsigned h = cams[0]->height;
+    // Process image, looking for the object and goal of the pusher task
+    PusherCommon::Scratch& scratch = PusherCommon::getScratch(entity);
+    const Color taskObjectColor = objectColors[pusher->task()];
+    const Color taskGoalColor = goalColors[pusher->task()];
     const int startY = h * 0.85;
     for (int y = startY; y >= 0; y--) // Scan from bottom to top (ignore lower pixels where robot is visible)
-        for (unsigned x = 0; x < w * 4; x++) {
-            // Get pixel values
-            const uint8_t* img = images[x / w];
-            unsigned idx = (y * w + (x % w)) * 3;
-            Color color = {img[idx + 0], img[idx + 1], img[idx + 2]};
+        for (unsigned x = 0; x < rowSize; x++) {
+            Color color = pixelAt(x, y);
 
             // Update distances
-            if (color == objectColor)
+            if (color == taskObjectColor)
                 pusher->objectDistance = y / float(h);
-            if (color == goalColor)
+            if (color == taskGoalColor)
                 pusher->goalDistance = y / float(h);
 
             // Update goal/object directions
-            if (color == objectColor && std::isnan(pusher->objectDirection))
-                pusher->objectDirection = calcDirection(cams, y, objectColor);
-            if (color == goalColor && std::isnan(pusher->goalDirection))
-                pusher->goalDirection = calcDirection(cams, y, goalColor);
+            if (color == taskObjectColor && std::isnan(pusher->objectDirection))
+                pusher->objectDirection = calcDirection(rowSize, pixelAt, y, taskObjectColor, scratch);
+            if (color == taskGoalColor && std::isnan(pusher->goalDirection))
+                pusher->goalDirection = calcDirection(rowSize, pixelAt, y, taskGoalColor, scratch);
 
             // Update push direction
             if (std::isnan(pusher->pushDirection)) {
                 // Get pixel below
-                unsigned idxB = ((y + 1) * w + (x % w)) * 3;
-                Color colorBelow = {img[idxB + 0], img[idxB + 1], img[idxB + 2]};
+                Color colorBelow = pixelAt(x, y + 1);
                 // Check if pixel is object is pixel below is not pusher
-                if (color == objectColor && colorBelow != pusherColor && (y == startY || colorBelow != objectColor))
-                    pusher->pushDirection = calcDirection(cams, y, objectColor);
+                if (color == taskObjectColor && colorBelow != pusherColor && (y == startY || colorBelow != taskObjectColor))
+                    pusher->pushDirection = calcDirection(rowSize, pixelAt, y, taskObjectColor, scratch);
             }
         }
 
     if (pusher->canSeeGoal() && pusher->canSeeObject())
         // Update angle between goal and object greater than 90
-        pusher->angleGreater90 = angleDistance(pusher->goalDirection, pusher->objectDirection) > M_PI / 2.0f;
+        pusher->setFlag(PusherComponent::ANGLE_GREATER_90, angleDistance(pusher->goalDirection, pusher->objectDirection) > M_PI / 2.0f);
     else if (pusher->canSeeGoal() && !pusher->canSeeObject())
         // Don't do angle check if only goal is visible
-        pusher->angleGreater90 = true;
+        pusher->setFlag(PusherComponent::ANGLE_GREATER_90, true);
 }
 
+void PusherCommon::processCameras(cmp::Entity entity, PusherComponent* pusher, std::array<cmp::CameraSensor*, 4> cams) {
+    PROFILE_STAGE(Telemetry::PROCESS_CAMERAS);
+    TRACE_SCOPE("PusherCommon::processCameras");
+    AllocCounter::Scope allocScope(AllocCounter::VISION);
+
+    // Row of colors is the four images side by side
+    std::array<const uint8_t*, 4> images = {cams[0]->getImage(), cams[1]->getImage(), cams[2]->getImage(), cams[3]->getImage()};
+    const unsigned w = cams[0]->width;
+    auto pixelAt = [&](unsigned x, unsigned y) {
+        const uint8_t* img = images[x / w];
+        unsigned idx = (y * w + (x % w)) * 3;
+        return Color(img[idx + 0], img[idx + 1], img[idx + 2]);
+    };
+    processImage(entity, pusher, cams[0]->captureTime, w * 4, cams[0]->height, pixelAt);
+}
+
+void PusherCommon::processPanorama(cmp::Entity entity, PusherComponent* pusher, const PusherSensorsComponent* sensors) {
+    PROFILE_STAGE(Telemetry::PROCESS_CAMERAS);
+    TRACE_SCOPE("PusherCommon::processPanorama");
+    AllocCounter::Scope allocScope(AllocCounter::VISION);
+
+    // Pixel classes are mapped to the colors the cameras would see
+    constexpr unsigned w = PusherSensorsComponent::panoramaWidth;
+    auto pixelAt = [&](unsigned x, unsigned y) { return panoramaColor(sensors->panorama[y * w + x]); };
+    processImage(entity, pusher, sensors->captureTime, w, PusherSensorsComponent::panoramaHeight, pixelAt);
+}
+
+Color PusherCommon::panoramaColor(uint8_t pixel) {
+    if (pixel == PusherSensorsComponent::PUSHER)
+        return pusherColor;
+    if (pixel < PusherSensorsComponent::OBJECT || pixel >= PusherSensorsComponent::objectPixel(maxTasks))
+        return Color(0, 0, 0);
+    const unsigned task = (pixel - PusherSensorsComponent::OBJECT) / 2;
+    return pixel == PusherSensorsComponent::objectPixel(task) ? objectColors[task] : goalColors[task];
+}
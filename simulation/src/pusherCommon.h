@@ -5,26 +5,71 @@
 //--------------------------------------------------
 #ifndef PUSHER_COMMON_H
 #define PUSHER_COMMON_H
+#include "allocCounter.h"
 #include "common.h"
+#include "controlKernels.h"
+#include "controllerParams.h"
 #include "pusherComponent.h"
+#include "pusherSensorsComponent.h"
 #include <atta/component/components/cameraSensor.h>
+#include <vector>
 
 namespace PusherCommon {
 
+// Runtime settings shared by all pusher scripts
+struct Settings {
+    bool frameSynchronous = false; // Only run the state machine on new camera frames or infrared changes
+    float irTolerance = 1e-3f;     // Infrared change (m) considered a change by frameSynchronous, ignores solver jitter
+    bool batchedActuation = false; // Queue motor commands and apply them for all pushers in one pass
+    bool staggeredCapture = false; // Spread the camera capture phase of the pushers over the capture period (off in the paper)
+};
+Settings& getSettings();
+// State machine parameters shared by all pusher scripts
+ControllerParams::Params& getParams();
+
+// Last motor command of each pusher
+struct Command {
+    atta::vec2 direction = atta::vec2(0.0f); // Desired direction (robot frame)
+    float linVel = 0.0f;                     // Forward velocity (robot frame)
+    float angVel = 0.0f;                     // Angular velocity
+    std::array<float, 8> irs = {};           // Infrared measurements when the command was computed
+    float elapsed = 0.0f;                    // Time since the command was computed
+    bool valid = false;
+    bool queued = false; // Waiting to be applied by flushCommands
+};
+Command& getCommand(cmp::Entity entity);
+// Apply the cached command given the current robot orientation (queued when using batched actuation)
+void applyCommand(cmp::Entity entity, Command& command);
+// Apply all queued commands
+void flushCommands();
+
+// Differential drive kinematics. flushCommands uses ControlKernels::computeDriveBatch, which computes the same velocities
+// from unit direction vectors without the atan2 -> cos/sin round trip
+void computeDrive(atta::vec2 direction, float& linVel, float& angVel);
+
+// Per-pusher memory reused across frames, so the control loop does not allocate in steady state
+struct Scratch {
+    ControlKernels::Intervals intervals{AllocCounter::getResource(AllocCounter::VISION)}; // Color intervals of a row
+};
+Scratch& getScratch(cmp::Entity entity);
+// Reserve the scratch for images with rows of rowSize pixels. Should be called when the simulation starts, the first sight of
+// a color can happen long after the warm-up steps
+void reserveScratch(cmp::Entity entity, unsigned rowSize);
+
 // Auxiliary
 void changeState(PusherComponent* pusher, PusherComponent::State state);
 void move(cmp::Entity entity, atta::vec2 direction);
 atta::vec2 dirToVec(float dir);
 float distInDirection(const std::array<float, 8>& irs, float dir);
-
-// States
-void randomWalk(cmp::Entity entity, PusherComponent* pusher, float dt, bool isPaperScript);
-void approachObject(cmp::Entity entity, PusherComponent* pusher, const std::array<float, 8>& irs, bool isPaperScript);
-void moveAroundObject(cmp::Entity entity, PusherComponent* pusher, const std::array<float, 8>& irs, float dt, bool isPaperScript);
-void pushObject(cmp::Entity entity, PusherComponent* pusher);
+// If any infrared measurement differs by more than the tolerance (or only one of them is NaN)
+bool irsChanged(const std::array<float, 8>& irs, const std::array<float, 8>& prev, float tolerance);
 
 // Processing
-void processCameras(PusherComponent* pusher, std::array<cmp::CameraSensor*, 4> cams);
+void processCameras(cmp::Entity entity, PusherComponent* pusher, std::array<cmp::CameraSensor*, 4> cams);
+// Same processing on the panorama of a lightweight pusher
+void processPanorama(cmp::Entity entity, PusherComponent* pusher, const PusherSensorsComponent* sensors);
+// Color the cameras would see for a panorama pixel class (black for the background and walls)
+Color panoramaColor(uint8_t pixel);
 
 } // namespace PusherCommon
 
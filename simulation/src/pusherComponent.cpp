@@ -4,6 +4,14 @@
 // Date: 2022-11-06
 //--------------------------------------------------
 #include "pusherComponent.h"
+#include "allocCounter.h"
+#include "chunkedStore.h"
+
+static_assert(sizeof(PusherComponent) == 32, "PusherComponent should fit in 32 bytes");
+
+ChunkedStore<PusherComponent::Cold> colds(AllocCounter::getResource(AllocCounter::CONTROL));
+
+PusherComponent::Cold& PusherComponent::cold(cmp::Entity entity) { return colds[entity.getId()]; }
 
 template <>
 cmp::ComponentDescription& cmp::TypedComponentRegistry<PusherComponent>::getDescription() {
@@ -18,20 +26,19 @@ cmp::ComponentDescription& cmp::TypedComponentRegistry<PusherComponent>::getDesc
              {},
              {"RANDOM_WALK", "APPROACH_OBJECT", "MOVE_AROUND_OBJECT", "PUSH_OBJECT", "BE_A_GOAL"}},
             {AttributeType::FLOAT32, offsetof(PusherComponent, timer), "timer"},
-            {AttributeType::FLOAT32, offsetof(PusherComponent, lastFrameTime), "lastFrameTime"},
-            {AttributeType::FLOAT32, offsetof(PusherComponent, beAGoalWait), "beAGoalWait"},
-            {AttributeType::FLOAT32, offsetof(PusherComponent, randomWalkAux), "randomWalkAux"},
-            {AttributeType::BOOL, offsetof(PusherComponent, clockwise), "clockwise"},
-            {AttributeType::BOOL, offsetof(PusherComponent, couldSeeGoal), "couldSeeGoal"},
-            {AttributeType::BOOL, offsetof(PusherComponent, angleGreater90), "angleGreater90"},
             {AttributeType::FLOAT32, offsetof(PusherComponent, objectDirection), "objectDirection"},
             {AttributeType::FLOAT32, offsetof(PusherComponent, objectDistance), "objectDistance"},
             {AttributeType::FLOAT32, offsetof(PusherComponent, goalDirection), "goalDirection"},
             {AttributeType::FLOAT32, offsetof(PusherComponent, goalDistance), "goalDistance"},
             {AttributeType::FLOAT32, offsetof(PusherComponent, pushDirection), "pushDirection"},
+            // One view per byte of the flags word (little endian)
+            {AttributeType::BOOL, offsetof(PusherComponent, flags) + 0, "clockwise"},
+            {AttributeType::BOOL, offsetof(PusherComponent, flags) + 1, "couldSeeGoal"},
+            {AttributeType::BOOL, offsetof(PusherComponent, flags) + 2, "angleGreater90"},
+            {AttributeType::UINT8, offsetof(PusherComponent, flags) + 3, "task"},
         },
         // Max instances
-        1024,
+        PusherComponent::maxInstances,
     };
 
     return desc;
@@ -5,6 +5,7 @@
 //--------------------------------------------------
 #ifndef PUSHER_COMPONENT_H
 #define PUSHER_COMPONENT_H
+#include <array>
 #include <atta/component/interface.h>
 
 namespace cmp = atta::component;
@@ -17,23 +18,29 @@ struct PusherComponent final : public cmp::Component {
         PUSH_OBJECT,
         BE_A_GOAL,
     };
+    static constexpr std::array<const char*, 5> stateNames = {"RANDOM_WALK", "APPROACH_OBJECT", "MOVE_AROUND_OBJECT", "PUSH_OBJECT", "BE_A_GOAL"};
+    // Each flag is the lowest bit of its own byte of the flags word, so the inspector can show every flag as a bool
+    enum Flag : uint32_t {
+        CLOCKWISE = 1 << 0,         // If should walk around object clockwise
+        COULD_SEE_GOAL = 1 << 8,    // If could see goal in the last frame
+        ANGLE_GREATER_90 = 1 << 16, // Check if angle was greater than 90 when goal and object were visible
+    };
+    static constexpr uint32_t taskShift = 24; // Flags bits 24-31 hold the object/goal pair the pusher works on
     static constexpr float beAGoalTimeout = 99999.0f;
-    static constexpr float pushObjectTimeout = 60.0f;
+    // Maximum swarm size, atta preallocates this many instances when the component is registered
+    static constexpr uint32_t maxInstances = 8192;
+
+    // State that is not read every tick, kept out of the component so the component pool stays compact. Stored per entity
+    // in chunks that are allocated as the swarm grows
+    struct Cold {
+        float lastFrameTime = 0.0f;
+        float beAGoalWait = 0.0f;   // Used to avoid switching back and forth between random and goal state
+        float randomWalkAux = 0.0f; // Auxiliar parameter to perform random walk
+    };
+    static Cold& cold(cmp::Entity entity);
 
     State state = State::RANDOM_WALK;
     float timer = 0.0f; // Timer to change state
-    float lastFrameTime = 0.0f;
-    float beAGoalWait = 0.0f; // Used to avoid switching back and forth between random and goal state
-
-    // Auxiliar parameters
-    float randomWalkAux = 0.0f; // Auxiliar parameter to perform random walk
-    bool clockwise = true;      // If should walk around object clockwise
-    bool couldSeeGoal = false;  // If could see goal in the last frame
-    bool angleGreater90 = true; // Check if angle was greater than 90 when goal and object were visible
-
-    bool canSeeObject() { return !std::isnan(objectDistance); }
-    bool canSeeGoal() { return !std::isnan(goalDistance); }
-    bool freeSpaceToPush() { return !std::isnan(pushDirection); }
 
     // Cache image processing result
     float objectDirection = NAN; // Direction [-pi, pi]
@@ -41,6 +48,19 @@ struct PusherComponent final : public cmp::Component {
     float goalDirection = NAN;   // Direction [-pi, pi]
     float goalDistance = NAN;    // Distance in pixels from top to bottom
     float pushDirection = NAN;   // Direction [-pi, pi]
+
+    uint32_t flags = CLOCKWISE | ANGLE_GREATER_90;
+
+    bool canSeeObject() { return !std::isnan(objectDistance); }
+    bool canSeeGoal() { return !std::isnan(goalDistance); }
+    bool freeSpaceToPush() { return !std::isnan(pushDirection); }
+
+    bool clockwise() const { return flags & CLOCKWISE; }
+    bool couldSeeGoal() const { return flags & COULD_SEE_GOAL; }
+    bool angleGreater90() const { return flags & ANGLE_GREATER_90; }
+    void setFlag(Flag flag, bool value) { flags = value ? (flags | flag) : (flags & ~flag); }
+    unsigned task() const { return (flags >> taskShift) & 0xff; }
+    void setTask(unsigned task) { flags = (flags & ~(0xffu << taskShift)) | (task << taskShift); }
 };
 ATTA_REGISTER_COMPONENT(PusherComponent);
 template <>
@@ -0,0 +1,342 @@
+//--------------------------------------------------
+// Box Pushing
+// pusherController.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef PUSHER_CONTROLLER_H
+#define PUSHER_CONTROLLER_H
+#include "lodScheduler.h"
+#include "pusherCommon.h"
+#include "pusherComponent.h"
+#include "pusherSensorsComponent.h"
+#include "sensorModel.h"
+#include "telemetry.h"
+#include "traceRecorder.h"
+#include <atta/component/components/cameraSensor.h>
+#include <atta/component/components/infraredSensor.h>
+#include <atta/component/components/material.h>
+#include <atta/script/interface.h>
+#include <atta/script/script.h>
+
+namespace cmp = atta::component;
+namespace scr = atta::script;
+
+//---------- Policies ----------//
+// A policy selects the controller behaviour at compile time. It must provide:
+//   traceName             -> name of the update scope in the trace
+//   requireGoalToApproach -> only approach the object when the goal is also visible
+//   subGoals              -> enable the BE_A_GOAL state (robots become sub-goals when they lose sight of the goal)
+//   chooseSideTowardsGoal -> choose clockwise/anti-clockwise when moving around the object based on the goal direction
+//   hasLeader             -> if true, the policy must provide isLeader(entity) and lead(entity) to override the state machine
+
+// Chen et al. (2015)
+struct ChenPolicy {
+    static constexpr const char* traceName = "PusherPaperScript::update";
+    static constexpr bool requireGoalToApproach = false;
+    static constexpr bool subGoals = false;
+    static constexpr bool chooseSideTowardsGoal = true;
+    static constexpr bool hasLeader = false;
+};
+
+// Proposed strategy with sub-goals
+struct SubGoalPolicy {
+    static constexpr const char* traceName = "PusherScript::update";
+    static constexpr bool requireGoalToApproach = true;
+    static constexpr bool subGoals = true;
+    static constexpr bool chooseSideTowardsGoal = true;
+    static constexpr bool hasLeader = false;
+};
+
+//---------- Controller ----------//
+template <typename Policy>
+class PusherController : public scr::Script {
+  public:
+    void update(cmp::Entity entity, float dt) override;
+
+  protected:
+    void control(cmp::Entity entity, float dt);
+
+    // States
+    void randomWalk();
+    void approachObject();
+    void moveAroundObject();
+    void pushObject();
+    void beAGoal();
+
+    cmp::Entity _entity;
+    float _dt;
+
+    PusherComponent* _pusher;
+    PusherComponent::Cold* _cold;
+    PusherSensorsComponent* _sensors; // Only for lightweight pushers, which have no camera/infrared children
+    std::array<cmp::CameraSensor*, 4> _cams;
+    Lod::CameraRates _rates;
+    std::array<float, 8> _irs;
+};
+
+template <typename Policy>
+void PusherController<Policy>::update(cmp::Entity entity, float dt) {
+    control(entity, dt);
+
+    // With batched actuation, the last pusher applies the commands of all pushers
+    if (PusherCommon::getSettings().batchedActuation) {
+        const std::vector<cmp::Entity>& clones = cmp::getFactory(pusherProto)->getClones();
+        if (!clones.empty() && entity.getId() == clones.back().getId())
+            PusherCommon::flushCommands();
+    }
+}
+
+template <typename Policy>
+void PusherController<Policy>::control(cmp::Entity entity, float dt) {
+    PROFILE_STAGE(Telemetry::FSM_UPDATE);
+    AllocCounter::Scope allocScope(AllocCounter::CONTROL);
+    _entity = entity;
+    _dt = dt;
+    _pusher = _entity.get<PusherComponent>();
+    _cold = &PusherComponent::cold(_entity);
+    TRACE_SCOPE(Policy::traceName, entity.getId(), _pusher->state);
+
+    _sensors = _entity.get<PusherSensorsComponent>();
+    if (_sensors) {
+        // Lightweight pusher
+        SensorModel::update(_entity, _sensors);
+        _irs = _sensors->irs;
+        _rates.fill(&_sensors->fps);
+    } else {
+        // Get cameras
+        cmp::Entity cameras = _entity.getChild(0);
+        for (int i = 0; i < 4; i++) {
+            _cams[i] = cameras.getChild(i).get<cmp::CameraSensor>();
+            _rates[i] = &_cams[i]->fps;
+        }
+
+        // Get infrareds
+        cmp::Entity infrareds = _entity.getChild(1);
+        for (int i = 0; i < 8; i++)
+            _irs[i] = infrareds.getChild(i).get<cmp::InfraredSensor>()->measurement;
+    }
+
+    _pusher->timer += dt;
+    if constexpr (Policy::subGoals)
+        _cold->beAGoalWait = std::max(0.0f, _cold->beAGoalWait - dt);
+
+    bool leader = false;
+    if constexpr (Policy::hasLeader)
+        leader = Policy::isLeader(_entity);
+
+    // Throttled pushers re-apply the last command without perception
+    PusherCommon::Command& command = PusherCommon::getCommand(_entity);
+    const bool lod = Lod::getSettings().enabled && !leader;
+    if (lod && !Lod::schedule(_entity, _irs, _rates)) {
+        command.elapsed += dt;
+        PusherCommon::applyCommand(_entity, command);
+        return;
+    }
+
+    const bool newFrame = (_sensors ? _sensors->captureTime : _cams[0]->captureTime) != _cold->lastFrameTime;
+    if (_sensors)
+        PusherCommon::processPanorama(_entity, _pusher, _sensors);
+    else
+        PusherCommon::processCameras(_entity, _pusher, _cams);
+
+    if constexpr (Policy::hasLeader) {
+        if (leader) {
+            PusherCommon::move(_entity, atta::vec2(0.0f));
+            Policy::lead(_entity);
+            return;
+        }
+    }
+
+    // Without new perception, re-apply the last command instead of running the state machine
+    const PusherCommon::Settings& settings = PusherCommon::getSettings();
+    if (settings.frameSynchronous && command.valid && !newFrame && !PusherCommon::irsChanged(_irs, command.irs, settings.irTolerance)) {
+        command.elapsed += dt;
+        PusherCommon::applyCommand(_entity, command);
+        return;
+    }
+    _dt = command.elapsed + dt; // Time since last decision
+    command.irs = _irs;
+    command.elapsed = 0.0f;
+
+    // Stop motors
+    PusherCommon::move(_entity, atta::vec2(0.0f));
+
+    switch (_pusher->state) {
+        case PusherComponent::RANDOM_WALK:
+            randomWalk();
+            break;
+        case PusherComponent::APPROACH_OBJECT:
+            approachObject();
+            break;
+        case PusherComponent::MOVE_AROUND_OBJECT:
+            moveAroundObject();
+            break;
+        case PusherComponent::PUSH_OBJECT:
+            pushObject();
+            break;
+        case PusherComponent::BE_A_GOAL:
+            if constexpr (Policy::subGoals)
+                beAGoal();
+            break;
+    }
+
+    if constexpr (Policy::subGoals) {
+        // Avoid turning into a goal if it was a goal a short time ago
+        if (_cold->beAGoalWait > 0.0f && _pusher->state == PusherComponent::BE_A_GOAL)
+            PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+
+        _entity.get<cmp::Material>()->set(_pusher->state == PusherComponent::BE_A_GOAL ? goalMaterials[_pusher->task()] : "pusher");
+    }
+
+    if (lod)
+        Lod::update(_entity, _pusher, _rates);
+}
+
+//---------- States ----------//
+template <typename Policy>
+void PusherController<Policy>::randomWalk() {
+    const ControllerParams::Params& params = PusherCommon::getParams();
+    const float a = params.randomWalkNoise;
+    const float b = params.randomWalkMaxDir;
+    _cold->randomWalkAux += _dt * (rand() / float(RAND_MAX) * a * 2 - a); // Add Unif(-a, a)
+
+    // Clip randomWalkAux angle
+    if (_cold->randomWalkAux < -b)
+        _cold->randomWalkAux = -b;
+    if (_cold->randomWalkAux > b)
+        _cold->randomWalkAux = b;
+    PusherCommon::move(_entity, PusherCommon::dirToVec(_cold->randomWalkAux));
+
+    if constexpr (Policy::subGoals) {
+        // If the goal is no longer visible
+        bool noLongerVisible = !_pusher->canSeeGoal() && _pusher->couldSeeGoal();
+        if (noLongerVisible && _pusher->angleGreater90()) {
+            PusherCommon::changeState(_pusher, PusherComponent::BE_A_GOAL);
+            return;
+        }
+    }
+
+    // Check if it can see
+    bool canSee = _pusher->canSeeObject() && (!Policy::requireGoalToApproach || _pusher->canSeeGoal());
+    if (canSee)
+        PusherCommon::changeState(_pusher, PusherComponent::APPROACH_OBJECT);
+}
+
+template <typename Policy>
+void PusherController<Policy>::approachObject() {
+    const ControllerParams::Params& params = PusherCommon::getParams();
+    const float minCamDist = params.minCamDist; // Minimum distance to the object to change state (using Camera)
+    const float minIrDist = params.minIrDist;   // Minimum distance to the object to change state (using IR)
+    const float minAngle = params.minAngle;     // The front angle interval is [-minAngle, minAngle]
+
+    // Check if it can still see
+    bool canSee = _pusher->canSeeObject() && (!Policy::requireGoalToApproach || _pusher->canSeeGoal());
+    if (!canSee) {
+        PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+        return;
+    }
+
+    float dir = _pusher->objectDirection;
+
+    // Move to object
+    PusherCommon::move(_entity, PusherCommon::dirToVec(dir));
+
+    // Check if arrived
+    bool isClose = _pusher->objectDistance < minCamDist &&                                    // If distance from camera is small
+                   PusherCommon::distInDirection(_irs, _pusher->objectDirection) < minIrDist; // And distance from IR is small
+    bool isInFront = (dir < minAngle && dir > -minAngle) || (dir < (-M_PI + minAngle) || dir > (M_PI - minAngle));
+    if (isClose && isInFront) {
+        if (!_pusher->canSeeGoal() && _pusher->freeSpaceToPush())
+            PusherCommon::changeState(_pusher, PusherComponent::PUSH_OBJECT);
+        else
+            PusherCommon::changeState(_pusher, PusherComponent::MOVE_AROUND_OBJECT);
+        return;
+    }
+}
+
+template <typename Policy>
+void PusherController<Policy>::moveAroundObject() {
+    const ControllerParams::Params& params = PusherCommon::getParams();
+
+    //----- Check lost object -----//
+    if (!_pusher->canSeeObject()) {
+        PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+        return;
+    }
+
+    //----- Check should push -----//
+    if (!_pusher->canSeeGoal() && _pusher->freeSpaceToPush()) {
+        PusherCommon::changeState(_pusher, PusherComponent::PUSH_OBJECT);
+        return;
+    }
+
+    //----- Timeout -----//
+    // If timer reached zero
+    if (_pusher->timer >= params.pushObjectTimeout) {
+        PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+        return;
+    }
+
+    //----- Select clockwise/anti-clockwise -----//
+    if constexpr (Policy::chooseSideTowardsGoal) {
+        if (_pusher->canSeeGoal()) {
+            float diff = _pusher->objectDirection - _pusher->goalDirection;
+            if (diff >= 2 * M_PI)
+                diff -= 2 * M_PI;
+            if (diff < 0)
+                diff += 2 * M_PI;
+            _pusher->setFlag(PusherComponent::CLOCKWISE, diff >= M_PI);
+        }
+    }
+
+    //----- Force field -----//
+    atta::vec2 objVec = PusherCommon::dirToVec(_pusher->objectDirection);
+
+    // Force to move around the object
+    atta::vec2 moveVec = atta::vec2(-objVec.y, objVec.x); // Robot move vector (X is to the forward, Y is left)
+    if (_pusher->clockwise())
+        moveVec *= -1;
+
+    // Force to keep distance from object
+    if (_pusher->objectDistance > params.keepCamDist || PusherCommon::distInDirection(_irs, _pusher->objectDirection) > params.keepIrDist)
+        moveVec += objVec;
+
+    //----- Output - move -----//
+    PusherCommon::move(_entity, moveVec);
+}
+
+template <typename Policy>
+void PusherController<Policy>::pushObject() {
+    // Can't see object anymore
+    if (!_pusher->canSeeObject()) {
+        PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+        return;
+    }
+
+    // Can see goal or no free space to push
+    if (_pusher->canSeeGoal() || !_pusher->freeSpaceToPush()) {
+        PusherCommon::changeState(_pusher, PusherComponent::MOVE_AROUND_OBJECT);
+        return;
+    }
+
+    // Timeout
+    if (_pusher->timer >= PusherCommon::getParams().pushObjectTimeout) {
+        PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+        return;
+    }
+
+    // Push
+    PusherCommon::move(_entity, PusherCommon::dirToVec(_pusher->objectDirection));
+}
+
+template <typename Policy>
+void PusherController<Policy>::beAGoal() {
+    bool objectIsClose = _pusher->objectDistance == 0.0f && PusherCommon::distInDirection(_irs, _pusher->objectDirection) < 0.1;
+    bool timeout = _pusher->timer >= PusherComponent::beAGoalTimeout;
+    if (_pusher->canSeeGoal() || objectIsClose || timeout) {
+        _cold->beAGoalWait = rand() / float(RAND_MAX) * PusherCommon::getParams().beAGoalMaxWait; // Wait before being a goal again
+        PusherCommon::changeState(_pusher, PusherComponent::RANDOM_WALK);
+    }
+}
+
+#endif // PUSHER_CONTROLLER_H
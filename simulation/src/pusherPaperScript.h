@@ -5,33 +5,9 @@
 //--------------------------------------------------
 #ifndef PUSHER_PAPER_SCRIPT_H
 #define PUSHER_PAPER_SCRIPT_H
-#include "pusherComponent.h"
-#include <atta/component/components/cameraSensor.h>
-#include <atta/component/components/infraredSensor.h>
-#include <atta/script/interface.h>
-#include <atta/script/script.h>
+#include "pusherController.h"
 
-namespace cmp = atta::component;
-namespace scr = atta::script;
-
-class PusherPaperScript : public scr::Script {
-  public:
-    void update(cmp::Entity entity, float dt) override;
-
-  private:
-    // States
-    void randomWalk();
-    void approachObject();
-    void moveAroundObject();
-    void pushObject();
-
-    cmp::Entity _entity;
-    float _dt;
-
-    PusherComponent* _pusher;
-    std::array<cmp::CameraSensor*, 4> _cams;
-    std::array<float, 8> _irs;
-};
+class PusherPaperScript : public PusherController<ChenPolicy> {};
 
 ATTA_REGISTER_SCRIPT(PusherPaperScript)
 
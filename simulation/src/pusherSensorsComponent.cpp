@@ -0,0 +1,30 @@
+//--------------------------------------------------
+// Box Pushing
+// pusherSensorsComponent.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "pusherSensorsComponent.h"
+
+template <>
+cmp::ComponentDescription& cmp::TypedComponentRegistry<PusherSensorsComponent>::getDescription() {
+    static cmp::ComponentDescription desc = {
+        "Pusher Sensors",
+        {
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, fps), "fps"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, captureTime), "captureTime"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irRange), "irRange"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 0 * sizeof(float), "ir0"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 1 * sizeof(float), "ir1"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 2 * sizeof(float), "ir2"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 3 * sizeof(float), "ir3"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 4 * sizeof(float), "ir4"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 5 * sizeof(float), "ir5"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 6 * sizeof(float), "ir6"},
+            {AttributeType::FLOAT32, offsetof(PusherSensorsComponent, irs) + 7 * sizeof(float), "ir7"},
+        },
+        // Max instances
+        PusherComponent::maxInstances,
+    };
+
+    return desc;
+}
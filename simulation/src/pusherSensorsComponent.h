@@ -0,0 +1,41 @@
+//--------------------------------------------------
+// Box Pushing
+// pusherSensorsComponent.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef PUSHER_SENSORS_COMPONENT_H
+#define PUSHER_SENSORS_COMPONENT_H
+#include "pusherComponent.h"
+#include <array>
+#include <atta/component/interface.h>
+
+namespace cmp = atta::component;
+
+// Sensors of a lightweight pusher, stored on the robot entity instead of camera and infrared child entities. They are
+// filled by SensorModel: the infrared ring is ray cast and the four cameras are replaced by one panorama with the same
+// layout as the four images side by side, holding the class of each pixel instead of its color
+struct PusherSensorsComponent final : public cmp::Component {
+    enum Pixel : uint8_t {
+        NONE = 0,
+        PUSHER,
+        WALL,
+        OBJECT, // Object/goal of the first task, task k uses OBJECT + 2k and GOAL + 2k
+        GOAL,
+    };
+    static constexpr uint8_t objectPixel(unsigned task) { return OBJECT + 2 * task; }
+    static constexpr uint8_t goalPixel(unsigned task) { return GOAL + 2 * task; }
+    static constexpr unsigned numIrs = 8;
+    static constexpr unsigned panoramaWidth = 128; // 90 degrees per camera
+    static constexpr unsigned panoramaHeight = 32;
+
+    float fps = 0.0f;          // Camera capture rate
+    float captureTime = -1.0f; // Time of the last panorama capture, negative if none yet
+    float irRange = 0.0f;      // Infrared measurement when nothing is detected
+    std::array<float, numIrs> irs = {};
+    std::array<uint8_t, panoramaWidth * panoramaHeight> panorama = {}; // Row major, row 0 on top
+};
+ATTA_REGISTER_COMPONENT(PusherSensorsComponent);
+template <>
+cmp::ComponentDescription& cmp::TypedComponentRegistry<PusherSensorsComponent>::getDescription();
+
+#endif // PUSHER_SENSORS_COMPONENT_H
@@ -4,7 +4,9 @@
 // Date: 2022-10-31
 //--------------------------------------------------
 #include "pusherTeleopScript.h"
+#include "allocCounter.h"
 #include "common.h"
+#include "mapInfo.h"
 #include "pusherCommon.h"
 #include <algorithm>
 #include <atta/component/components/material.h>
@@ -12,73 +14,27 @@
 #include <atta/component/components/transform.h>
 #include <atta/graphics/drawer.h>
 #include <atta/utils/config.h>
-#include <queue>
 
 namespace gfx = atta::graphics;
 namespace sns = atta::sensor;
 namespace evt = atta::event;
 
-void PusherTeleopScript::update(cmp::Entity entity, float dt) {
-    PROFILE();
-    _entity = entity;
-    _dt = dt;
-
-    // Get cameras
-    cmp::Entity cameras = _entity.getChild(0);
-    _cams[0] = cameras.getChild(0).get<cmp::CameraSensor>();
-    _cams[1] = cameras.getChild(1).get<cmp::CameraSensor>();
-    _cams[2] = cameras.getChild(2).get<cmp::CameraSensor>();
-    _cams[3] = cameras.getChild(3).get<cmp::CameraSensor>();
-
-    // Get infrareds
-    cmp::Entity infrareds = _entity.getChild(1);
-    for (int i = 0; i < 8; i++)
-        _irs[i] = infrareds.getChild(i).get<cmp::InfraredSensor>()->measurement;
-
-    _pusher = _entity.get<PusherComponent>();
-    _pusher->timer += dt;
-
-    PusherCommon::processCameras(_pusher, _cams);
-
-    // Stop motors
-    PusherCommon::move(_entity, atta::vec2(0.0f));
-
-    if (!cmp::getFactory(pusherProto)->getClones().empty() && entity.getId() == cmp::getFactory(pusherProto)->getClones()[0].getId()) {
-        // Teleoperated robot
-        teleoperate();
-    } else {
-        // Chen et al.
-        switch (_pusher->state) {
-            case PusherComponent::RANDOM_WALK:
-                randomWalk();
-                break;
-            case PusherComponent::APPROACH_OBJECT:
-                approachObject();
-                break;
-            case PusherComponent::MOVE_AROUND_OBJECT:
-                moveAroundObject();
-                break;
-            case PusherComponent::PUSH_OBJECT:
-                pushObject();
-                break;
-        }
-    }
-}
+template class PusherController<TeleopLeaderPolicy>;
 
 //---------- Teleoperation ----------//
-struct WallInfo {
-    atta::vec2 pos;
-    atta::vec2 size;
-};
-std::vector<WallInfo> teleopWalls;    ///< Map walls
-std::vector<WallInfo> teleopGapWalls; ///< Map walls with gap
-
-struct TeleopNode {
-    atta::vec2 pos;
-    std::vector<TeleopNode*> neighbors;
-};
-std::vector<TeleopNode> teleopNodes;
-std::vector<atta::vec2> teleopShortestPath;
+// All containers keep their capacity across frames, so planning does not allocate after the first frame of each run
+std::pmr::memory_resource* teleopResource = AllocCounter::getResource(AllocCounter::TELEOP);
+std::pmr::vector<WallInfo> teleopWalls{teleopResource};    ///< Map walls
+std::pmr::vector<WallInfo> teleopGapWalls{teleopResource}; ///< Map walls with gap
+float teleopWallsTime = -1.0f;                             ///< Simulation time when the walls were last updated
+atta::vec2 teleopArenaHalfSize{1.5f, 1.5f};                ///< Inside of the arena border walls
+
+std::pmr::vector<atta::vec2> teleopNodes{teleopResource};
+std::pmr::vector<uint8_t> teleopAdjacency{teleopResource}; ///< Node adjacency matrix
+std::pmr::vector<float> teleopDistances{teleopResource};
+std::pmr::vector<int> teleopPrevious{teleopResource};
+std::pmr::vector<uint8_t> teleopVisited{teleopResource};
+std::pmr::vector<atta::vec2> teleopShortestPath{teleopResource};
 
 bool linesIntersect(const atta::vec2& a1, const atta::vec2& a2, const atta::vec2& b1, const atta::vec2& b2) {
     auto cross = [](const atta::vec2& v1, const atta::vec2& v2) { return v1.x * v2.y - v1.y * v2.x; };
@@ -97,11 +53,9 @@ bool linesIntersect(const atta::vec2& a1, const atta::vec2& a2, const atta::vec2
     return t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1;
 }
 
-bool doesEdgeIntersectWalls(const atta::vec2& p1, const atta::vec2& p2, const std::vector<WallInfo>& walls) {
+bool doesEdgeIntersectWalls(const atta::vec2& p1, const atta::vec2& p2, const std::pmr::vector<WallInfo>& walls) {
     for (const auto& wall : walls) {
-        std::array<atta::vec2, 4> corners = {
-            wall.pos + 0.5f * atta::vec2{wall.size.x, wall.size.y}, wall.pos + 0.5f * atta::vec2{wall.size.x, -wall.size.y},
-            wall.pos + 0.5f * atta::vec2{-wall.size.x, -wall.size.y}, wall.pos + 0.5f * atta::vec2{-wall.size.x, wall.size.y}};
+        std::array<atta::vec2, 4> corners = getCorners(wall);
         if (linesIntersect(p1, p2, corners[0], corners[1]) || linesIntersect(p1, p2, corners[1], corners[2]) ||
             linesIntersect(p1, p2, corners[2], corners[3]) || linesIntersect(p1, p2, corners[3], corners[0])) {
             return true;
@@ -110,7 +64,7 @@ bool doesEdgeIntersectWalls(const atta::vec2& p1, const atta::vec2& p2, const st
     return false;
 }
 
-atta::vec2 findPositionAtDistance(const std::vector<atta::vec2>& path, float distance) {
+atta::vec2 findPositionAtDistance(const std::pmr::vector<atta::vec2>& path, float distance) {
     if (path.empty()) {
         LOG_DEBUG("PusherTeleopScript", "Path is empty");
         return {};
@@ -132,92 +86,120 @@ atta::vec2 findPositionAtDistance(const std::vector<atta::vec2>& path, float dis
     return path.back();
 }
 
-void PusherTeleopScript::teleoperate() {
+bool TeleopLeaderPolicy::isLeader(cmp::Entity entity) {
+    const std::vector<cmp::Entity>& clones = cmp::getFactory(pusherProto)->getClones();
+    return !clones.empty() && entity.getId() == clones[0].getId();
+}
+
+void TeleopLeaderPolicy::lead(cmp::Entity entity) {
+    AllocCounter::Scope allocScope(AllocCounter::TELEOP);
+
     //----- Create walls -----//
-    teleopWalls.clear();
-    teleopGapWalls.clear();
-    atta::vec3 objScale = object.get<cmp::Transform>()->scale;
-    float gap = std::max(objScale.x, objScale.y) * 0.5;
-    cmp::Relationship* obstR = obstacles.get<cmp::Relationship>();
-    for (cmp::Entity obst : obstR->getChildren()) {
-        cmp::Transform* t = obst.get<cmp::Transform>();
-        teleopWalls.push_back({.pos = {t->position.x, t->position.y}, .size = {t->scale.x, t->scale.y}});
-        teleopGapWalls.push_back({.pos = {t->position.x, t->position.y}, .size = {t->scale.x + 2 * gap, t->scale.y + 2 * gap}});
+    // Obstacles don't change during a run, only update them when a new run starts
+    if (teleopWalls.empty() || atta::Config::getTime() < teleopWallsTime) {
+        teleopWalls.clear();
+        teleopGapWalls.clear();
+        atta::vec3 objScale = object.get<cmp::Transform>()->scale;
+        float gap = std::max(objScale.x, objScale.y) * 0.5;
+        cmp::Relationship* obstR = obstacles.get<cmp::Relationship>();
+        std::vector<cmp::Entity> obsts = obstR->getChildren();
+        for (size_t i = 0; i < obsts.size(); i++) {
+            cmp::Transform* t = obsts[i].get<cmp::Transform>();
+            // The first four obstacles are the arena border
+            if (i < 4 && t->scale.x > t->scale.y)
+                teleopArenaHalfSize.y = std::abs(t->position.y) - t->scale.y * 0.5f;
+            else if (i < 4)
+                teleopArenaHalfSize.x = std::abs(t->position.x) - t->scale.x * 0.5f;
+            const float angle = t->orientation.get2DAngle();
+            teleopWalls.push_back({.pos = {t->position.x, t->position.y}, .size = {t->scale.x, t->scale.y}, .angle = angle});
+            teleopGapWalls.push_back(
+                {.pos = {t->position.x, t->position.y}, .size = {t->scale.x + 2 * gap, t->scale.y + 2 * gap}, .angle = angle});
+        }
+
+        // Reserve for the maximum number of nodes
+        const size_t maxNodes = teleopGapWalls.size() * 4 + 2;
+        teleopNodes.reserve(maxNodes);
+        teleopAdjacency.reserve(maxNodes * maxNodes);
+        teleopDistances.reserve(maxNodes);
+        teleopPrevious.reserve(maxNodes);
+        teleopVisited.reserve(maxNodes);
+        teleopShortestPath.reserve(maxNodes);
     }
+    teleopWallsTime = atta::Config::getTime();
 
     //----- Create nodes -----//
+    // Nodes outside of the arena are discarded, including the goal and the object
+    auto inArena = [](atta::vec2 pos) { return std::abs(pos.x) < teleopArenaHalfSize.x && std::abs(pos.y) < teleopArenaHalfSize.y; };
     teleopNodes.clear();
     for (const auto& w : teleopGapWalls) {
-        teleopNodes.push_back({.pos = w.pos + 0.5f * atta::vec2(w.size.x, w.size.y)});
-        teleopNodes.push_back({.pos = w.pos + 0.5f * atta::vec2(w.size.x, -w.size.y)});
-        teleopNodes.push_back({.pos = w.pos + 0.5f * atta::vec2(-w.size.x, -w.size.y)});
-        teleopNodes.push_back({.pos = w.pos + 0.5f * atta::vec2(-w.size.x, w.size.y)});
+        for (atta::vec2 pos : getCorners(w)) {
+            if (inArena(pos))
+                teleopNodes.push_back(pos);
+        }
+    }
+    int goalNode = -1;
+    int startNode = -1;
+    const atta::vec2 goalPos = atta::vec2(goal.get<cmp::Transform>()->position);
+    const atta::vec2 objectPos = atta::vec2(object.get<cmp::Transform>()->position);
+    if (inArena(goalPos)) {
+        goalNode = teleopNodes.size();
+        teleopNodes.push_back(goalPos);
     }
-    teleopNodes.push_back({.pos = atta::vec2(goal.get<cmp::Transform>()->position)});
-    teleopNodes.push_back({.pos = atta::vec2(object.get<cmp::Transform>()->position)});
-    for (int i = teleopNodes.size() - 1; i >= 0; i--) {
-        if (std::abs(teleopNodes[i].pos.x) >= 1.5f || std::abs(teleopNodes[i].pos.y) >= 1.5f)
-            teleopNodes.erase(teleopNodes.begin() + i);
+    if (inArena(objectPos)) {
+        startNode = teleopNodes.size();
+        teleopNodes.push_back(objectPos);
     }
+    const int numNodes = teleopNodes.size();
+
     //----- Create edges -----//
-    for (size_t i = 0; i < teleopNodes.size(); i++)
-        for (size_t j = 1; j < teleopNodes.size(); j++) {
-            if (!doesEdgeIntersectWalls(teleopNodes[i].pos, teleopNodes[j].pos, teleopWalls)) {
-                teleopNodes[i].neighbors.push_back(&teleopNodes[j]);
-                teleopNodes[j].neighbors.push_back(&teleopNodes[i]);
-            }
-        }
+    teleopAdjacency.assign(numNodes * numNodes, 0);
+    for (int i = 0; i < numNodes; i++)
+        for (int j = i + 1; j < numNodes; j++)
+            if (!doesEdgeIntersectWalls(teleopNodes[i], teleopNodes[j], teleopWalls))
+                teleopAdjacency[i * numNodes + j] = teleopAdjacency[j * numNodes + i] = 1;
 
     //----- Dijkstra's algorithm -----//
-    auto dijkstra = [&](TeleopNode& startNode, TeleopNode& goalNode) {
-        std::unordered_map<TeleopNode*, float> distances;
-        std::unordered_map<TeleopNode*, TeleopNode*> previous;
-        auto compare = [&](TeleopNode* lhs, TeleopNode* rhs) { return distances[lhs] > distances[rhs]; };
-        std::priority_queue<TeleopNode*, std::vector<TeleopNode*>, decltype(compare)> pq(compare);
-
-        for (auto& node : teleopNodes) {
-            distances[&node] = std::numeric_limits<float>::infinity();
-            previous[&node] = nullptr;
-        }
-        distances[&startNode] = 0.0f;
-        pq.push(&startNode);
-
-        while (!pq.empty()) {
-            TeleopNode* currentNode = pq.top();
-            pq.pop();
-
-            if (currentNode == &goalNode)
-                break;
-
-            for (TeleopNode* neighbor : currentNode->neighbors) {
-                float newDist = distances[currentNode] + length(neighbor->pos - currentNode->pos);
-                if (newDist < distances[neighbor]) {
-                    distances[neighbor] = newDist;
-                    previous[neighbor] = currentNode;
-                    pq.push(neighbor);
-                }
+    // The graph is small and dense, so the O(n^2) version without priority queue is used
+    teleopDistances.assign(numNodes, std::numeric_limits<float>::infinity());
+    teleopPrevious.assign(numNodes, -1);
+    teleopVisited.assign(numNodes, 0);
+    if (startNode != -1)
+        teleopDistances[startNode] = 0.0f;
+    while (goalNode != -1 && startNode != -1) {
+        int current = -1;
+        for (int i = 0; i < numNodes; i++)
+            if (!teleopVisited[i] && (current == -1 || teleopDistances[i] < teleopDistances[current]))
+                current = i;
+        if (current == -1 || current == goalNode || std::isinf(teleopDistances[current]))
+            break;
+        teleopVisited[current] = 1;
+
+        for (int neighbor = 0; neighbor < numNodes; neighbor++) {
+            if (!teleopAdjacency[current * numNodes + neighbor] || teleopVisited[neighbor])
+                continue;
+            float newDist = teleopDistances[current] + length(teleopNodes[neighbor] - teleopNodes[current]);
+            if (newDist < teleopDistances[neighbor]) {
+                teleopDistances[neighbor] = newDist;
+                teleopPrevious[neighbor] = current;
             }
         }
+    }
 
-        std::vector<atta::vec2> path;
-        for (TeleopNode* at = &goalNode; at != nullptr; at = previous[at])
-            path.push_back(at->pos);
-        std::reverse(path.begin(), path.end());
-        return path;
-    };
-
-    TeleopNode& startNode = *std::find_if(teleopNodes.begin(), teleopNodes.end(),
-                                          [&](const TeleopNode& node) { return node.pos == atta::vec2(object.get<cmp::Transform>()->position); });
-
-    TeleopNode& goalNode = *std::find_if(teleopNodes.begin(), teleopNodes.end(),
-                                         [&](const TeleopNode& node) { return node.pos == atta::vec2(goal.get<cmp::Transform>()->position); });
-
-    teleopShortestPath = dijkstra(startNode, goalNode);
+    teleopShortestPath.clear();
+    if (goalNode != -1 && startNode != -1)
+        for (int at = goalNode; at != -1; at = teleopPrevious[at])
+            teleopShortestPath.push_back(teleopNodes[at]);
+    std::reverse(teleopShortestPath.begin(), teleopShortestPath.end());
 
     //----- Move robot -----//
+    // Wait in place while the goal or the object is outside of the arena
+    if (teleopShortestPath.empty()) {
+        PusherCommon::move(entity, atta::vec2(0.0f));
+        return;
+    }
     constexpr float OBJECT_DISTANCE = 0.5f;
     atta::vec2 teleopPos = findPositionAtDistance(teleopShortestPath, OBJECT_DISTANCE);
-    cmp::Transform* t = _entity.get<cmp::Transform>();
+    cmp::Transform* t = entity.get<cmp::Transform>();
 
     // If less than 100ms of simulation, start at right position
     if (atta::Config::getTime() == 0.0f)
@@ -227,8 +209,8 @@ void PusherTeleopScript::teleoperate() {
     float angle = -t->orientation.get2DAngle();
     moveDir.normalize();
     moveDir = atta::vec2(std::cos(angle) * moveDir.x - std::sin(angle) * moveDir.y, std::sin(angle) * moveDir.x + std::cos(angle) * moveDir.y);
-    PusherCommon::move(_entity, moveDir);
-    _entity.get<cmp::Material>()->set("goal");
+    PusherCommon::move(entity, moveDir);
+    entity.get<cmp::Material>()->set("goal");
 
     //----- Graphical debugging -----//
     gfx::Drawer::clear("teleop");
@@ -250,13 +232,13 @@ void PusherTeleopScript::teleoperate() {
 
     // Plot good edges
     line.c0 = line.c1 = atta::vec4(0.4f, 0.2f, 0.8f, 1.0f);
-    for (const TeleopNode& n : teleopNodes) {
-        for (const TeleopNode* neighbor : n.neighbors) {
-            line.p0 = atta::vec3(n.pos, 0.3);
-            line.p1 = atta::vec3(neighbor->pos, 0.3);
-            gfx::Drawer::add(line, "teleop");
-        }
-    }
+    for (int i = 0; i < numNodes; i++)
+        for (int j = i + 1; j < numNodes; j++)
+            if (teleopAdjacency[i * numNodes + j]) {
+                line.p0 = atta::vec3(teleopNodes[i], 0.3);
+                line.p1 = atta::vec3(teleopNodes[j], 0.3);
+                gfx::Drawer::add(line, "teleop");
+            }
 
     // Plot shortest path
     line.c0 = line.c1 = atta::vec4(0.4f, 0.8f, 0.2f, 1.0f);
@@ -266,12 +248,3 @@ void PusherTeleopScript::teleoperate() {
         gfx::Drawer::add(line, "teleop");
     }
 }
-
-//---------- States ----------//
-void PusherTeleopScript::randomWalk() { PusherCommon::randomWalk(_entity, _pusher, _dt, true); }
-
-void PusherTeleopScript::approachObject() { PusherCommon::approachObject(_entity, _pusher, _irs, true); }
-
-void PusherTeleopScript::moveAroundObject() { PusherCommon::moveAroundObject(_entity, _pusher, _irs, _dt, false); }
-
-void PusherTeleopScript::pushObject() { PusherCommon::pushObject(_entity, _pusher); }
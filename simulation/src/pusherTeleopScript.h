@@ -5,36 +5,19 @@
 //--------------------------------------------------
 #ifndef PUSHER_TELEOP_SCRIPT_H
 #define PUSHER_TELEOP_SCRIPT_H
-#include "pusherComponent.h"
-#include <atta/component/components/cameraSensor.h>
-#include <atta/component/components/infraredSensor.h>
-#include <atta/script/interface.h>
-#include <atta/script/script.h>
+#include "pusherController.h"
 
-namespace cmp = atta::component;
-namespace scr = atta::script;
+// Chen et al. (2015), with the first robot teleoperated to lead the object along the shortest path
+struct TeleopLeaderPolicy : public ChenPolicy {
+    static constexpr const char* traceName = "PusherTeleopScript::update";
+    static constexpr bool hasLeader = true;
 
-class PusherTeleopScript : public scr::Script {
-  public:
-    void update(cmp::Entity entity, float dt) override;
-
-  private:
-    void teleoperate();
-
-    // States
-    void randomWalk();
-    void approachObject();
-    void moveAroundObject();
-    void pushObject();
-
-    cmp::Entity _entity;
-    float _dt;
-
-    PusherComponent* _pusher;
-    std::array<cmp::CameraSensor*, 4> _cams;
-    std::array<float, 8> _irs;
+    static bool isLeader(cmp::Entity entity);
+    static void lead(cmp::Entity entity);
 };
 
+class PusherTeleopScript : public PusherController<TeleopLeaderPolicy> {};
+
 ATTA_REGISTER_SCRIPT(PusherTeleopScript)
 
 #endif // PUSHER_TELEOP_SCRIPT_H
@@ -0,0 +1,373 @@
+//--------------------------------------------------
+// Box Pushing
+// replay.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "replay.h"
+#include "common.h"
+#include <algorithm>
+#include <atta/component/components/transform.h>
+#include <atta/utils/config.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace Replay {
+
+struct FileHeader {
+    char magic[4] = {'B', 'P', 'R', 'P'};
+    uint32_t version = 2; // 2: one byte per pusher flag, task in bits 24-31
+    uint32_t numRobots = 0;
+    uint32_t numFrames = 0;
+    uint32_t keyframeInterval = 0;
+    float dt = 0.0f;
+    float goalX = 0.0f;
+    float goalY = 0.0f;
+    float goalRadius = 0.0f;
+    float objectRadius = 0.0f;
+    float pusherRadius = 0.0f;
+    uint32_t mapLength = 0; // Followed by the map and object names
+    uint32_t objectLength = 0;
+    uint32_t reserved = 0;
+    uint64_t dataSize = 0; // Followed by the encoded frames and the keyframe offsets
+};
+
+//---------- Quantization ----------//
+constexpr int64_t nanCode = INT32_MIN; // Vision outputs are NaN when nothing is seen
+constexpr float posScale = 1e-4f;      // 0.1mm
+constexpr float angleScale = 1e-4f;    // 0.1mrad
+constexpr float distScale = 1e-2f;     // Vision distances are in pixels
+constexpr size_t frameValues = 4;      // Step, object x, y, angle
+constexpr size_t sampleValues = 11;
+
+int64_t quantize(float v, float scale) { return std::isnan(v) ? nanCode : std::llround(v / scale); }
+float dequantize(int64_t q, float scale) { return q == nanCode ? NAN : q * scale; }
+
+void quantizeFrame(const FrameHeader& frame, const RobotSample* samples, uint32_t numRobots, float dt, int64_t* q) {
+    *q++ = std::llround(frame.time / dt);
+    *q++ = quantize(frame.objectX, posScale);
+    *q++ = quantize(frame.objectY, posScale);
+    *q++ = quantize(frame.objectAngle, angleScale);
+    for (uint32_t i = 0; i < numRobots; i++) {
+        const RobotSample& s = samples[i];
+        *q++ = quantize(s.x, posScale);
+        *q++ = quantize(s.y, posScale);
+        *q++ = quantize(s.angle, angleScale);
+        *q++ = s.state;
+        *q++ = s.flags;
+        *q++ = s.entity;
+        *q++ = quantize(s.objectDirection, angleScale);
+        *q++ = quantize(s.objectDistance, distScale);
+        *q++ = quantize(s.goalDirection, angleScale);
+        *q++ = quantize(s.goalDistance, distScale);
+        *q++ = quantize(s.pushDirection, angleScale);
+    }
+}
+
+void dequantizeFrame(const int64_t* q, uint32_t numRobots, float dt, FrameHeader& frame, RobotSample* samples) {
+    frame.time = *q++ * dt;
+    frame.objectX = dequantize(*q++, posScale);
+    frame.objectY = dequantize(*q++, posScale);
+    frame.objectAngle = dequantize(*q++, angleScale);
+    for (uint32_t i = 0; i < numRobots; i++) {
+        RobotSample& s = samples[i];
+        s.x = dequantize(*q++, posScale);
+        s.y = dequantize(*q++, posScale);
+        s.angle = dequantize(*q++, angleScale);
+        s.state = *q++;
+        s.flags = *q++;
+        s.entity = *q++;
+        s.objectDirection = dequantize(*q++, angleScale);
+        s.objectDistance = dequantize(*q++, distScale);
+        s.goalDirection = dequantize(*q++, angleScale);
+        s.goalDistance = dequantize(*q++, distScale);
+        s.pushDirection = dequantize(*q++, angleScale);
+    }
+}
+
+//---------- Variable length integers ----------//
+void putVarint(std::vector<uint8_t>& data, int64_t v) {
+    uint64_t u = (uint64_t(v) << 1) ^ uint64_t(v >> 63); // Zigzag, small deltas of any sign use few bytes
+    while (u >= 0x80) {
+        data.push_back(uint8_t(u) | 0x80);
+        u >>= 7;
+    }
+    data.push_back(uint8_t(u));
+}
+
+bool getVarint(const std::vector<uint8_t>& data, uint64_t& offset, int64_t& v) {
+    uint64_t u = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (offset >= data.size())
+            return false;
+        uint8_t byte = data[offset++];
+        u |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            v = int64_t(u >> 1) ^ -int64_t(u & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------- Recorder state ----------//
+Settings settings;
+Info info;
+Encoder encoder;
+std::FILE* spill = nullptr; // Flushed encoder data of the current recording
+std::vector<cmp::Entity> pushers;
+std::vector<RobotSample> samples;
+
+void closeSpill() {
+    if (spill)
+        std::fclose(spill);
+    spill = nullptr;
+}
+
+} // namespace Replay
+
+//---------- Encoder ----------//
+void Replay::Encoder::start(uint32_t numRobots, uint32_t interval, float timeStep) {
+    data.clear();
+    flushed = 0;
+    keyframes.clear();
+    numFrames = 0;
+    keyframeInterval = std::max(interval, 1u);
+    dt = timeStep;
+    _prev.assign(frameValues + sampleValues * numRobots, 0);
+    _curr.assign(_prev.size(), 0);
+}
+
+void Replay::Encoder::add(const FrameHeader& frame, const RobotSample* samples) {
+    const uint32_t numRobots = (_prev.size() - frameValues) / sampleValues;
+    quantizeFrame(frame, samples, numRobots, dt, _curr.data());
+
+    // Keyframes are encoded against zero so decoding can start from them
+    if (numFrames % keyframeInterval == 0) {
+        keyframes.push_back(flushed + data.size());
+        std::fill(_prev.begin(), _prev.end(), 0);
+    }
+    for (size_t i = 0; i < _curr.size(); i++)
+        putVarint(data, _curr[i] - _prev[i]);
+    _prev.swap(_curr);
+    numFrames++;
+}
+
+//---------- Recording ----------//
+bool Replay::Recording::load(const std::string& file) {
+    clear();
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return false;
+
+    in.seekg(0, std::ios::end);
+    const uint64_t fileSize = in.tellg();
+    in.seekg(0);
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)))
+        return false;
+    in.seekg(0);
+
+    if (std::memcmp(magic, FileHeader{}.magic, sizeof(magic)) == 0) {
+        // Replay file
+        FileHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.version != FileHeader{}.version)
+            return false;
+
+        // Check the sizes against the file before allocating. Every encoded value takes at least one byte
+        const uint64_t interval = std::max(header.keyframeInterval, 1u);
+        const uint64_t numKeyframes = (uint64_t(header.numFrames) + interval - 1) / interval;
+        const uint64_t frameSize = frameValues + sampleValues * uint64_t(header.numRobots);
+        const uint64_t available = fileSize - sizeof(header);
+        if (header.dataSize > available || uint64_t(header.mapLength) + header.objectLength > available - header.dataSize ||
+            numKeyframes > (available - header.dataSize - header.mapLength - header.objectLength) / sizeof(uint64_t) ||
+            uint64_t(header.mapLength) + header.objectLength + header.dataSize + numKeyframes * sizeof(uint64_t) != available ||
+            header.numFrames == 0 || frameSize > header.dataSize / header.numFrames)
+            return false;
+
+        _info.map.resize(header.mapLength);
+        _info.object.resize(header.objectLength);
+        in.read(_info.map.data(), header.mapLength);
+        in.read(_info.object.data(), header.objectLength);
+        _info.dt = header.dt;
+        _info.goalX = header.goalX;
+        _info.goalY = header.goalY;
+        _info.goalRadius = header.goalRadius;
+        _info.objectRadius = header.objectRadius;
+        _info.pusherRadius = header.pusherRadius;
+        _info.numRobots = header.numRobots;
+
+        _encoded.start(header.numRobots, header.keyframeInterval, header.dt);
+        _encoded.numFrames = header.numFrames;
+        _encoded.data.resize(header.dataSize);
+        _encoded.keyframes.resize((header.numFrames + _encoded.keyframeInterval - 1) / _encoded.keyframeInterval);
+        in.read(reinterpret_cast<char*>(_encoded.data.data()), header.dataSize);
+        in.read(reinterpret_cast<char*>(_encoded.keyframes.data()), _encoded.keyframes.size() * sizeof(uint64_t));
+        if (!in) {
+            clear();
+            return false;
+        }
+        for (size_t i = 0; i < _encoded.keyframes.size(); i++)
+            if (_encoded.keyframes[i] >= header.dataSize || (i > 0 && _encoded.keyframes[i] <= _encoded.keyframes[i - 1])) {
+                clear();
+                return false;
+            }
+    } else if (std::memcmp(magic, FlightRecorder::FileHeader{}.magic, sizeof(magic)) == 0) {
+        // Flight recorder dump, encoded on load so both are played back the same way
+        FlightRecorder::FileHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.version != FlightRecorder::FileHeader{}.version)
+            return false;
+        const uint64_t frameSize = sizeof(FrameHeader) + uint64_t(header.numRobots) * sizeof(RobotSample);
+        if (header.numFrames == 0 || frameSize > (fileSize - sizeof(header)) / header.numFrames)
+            return false;
+        _info.dt = header.dt;
+        _info.numRobots = header.numRobots;
+        _info.pusherRadius = pusherProto.get<cmp::Transform>()->scale.x * 0.5f;
+
+        _encoded.start(header.numRobots, settings.keyframeInterval, header.dt);
+        std::vector<RobotSample> frameSamples(header.numRobots);
+        for (uint32_t i = 0; i < header.numFrames; i++) {
+            FrameHeader frame;
+            in.read(reinterpret_cast<char*>(&frame), sizeof(frame));
+            in.read(reinterpret_cast<char*>(frameSamples.data()), frameSamples.size() * sizeof(RobotSample));
+            if (!in)
+                break;
+            _encoded.add(frame, frameSamples.data());
+        }
+    } else
+        return false;
+
+    // Object path for drawing
+    FrameHeader frame;
+    std::vector<RobotSample> frameSamples;
+    _objectPath.reserve(_encoded.numFrames);
+    for (uint32_t i = 0; i < _encoded.numFrames; i++) {
+        if (!getFrame(i, frame, frameSamples)) {
+            clear();
+            return false;
+        }
+        _objectPath.push_back(atta::vec2(frame.objectX, frame.objectY));
+    }
+    return true;
+}
+
+void Replay::Recording::clear() {
+    _info = {};
+    _encoded = {};
+    _objectPath.clear();
+    _nextFrame = 0;
+    _offset = 0;
+    _prev.clear();
+}
+
+bool Replay::Recording::getFrame(uint32_t idx, FrameHeader& frame, std::vector<RobotSample>& samples) {
+    if (idx >= _encoded.numFrames)
+        return false;
+
+    // Seek to the keyframe unless the frame is ahead in the same keyframe interval
+    const uint32_t keyframe = idx / _encoded.keyframeInterval;
+    if (idx < _nextFrame || keyframe * _encoded.keyframeInterval > _nextFrame) {
+        _nextFrame = keyframe * _encoded.keyframeInterval;
+        _offset = _encoded.keyframes[keyframe];
+    }
+    samples.resize(_info.numRobots);
+    while (_nextFrame <= idx)
+        if (!decodeNext(frame, samples))
+            return false;
+    return true;
+}
+
+bool Replay::Recording::decodeNext(FrameHeader& frame, std::vector<RobotSample>& samples) {
+    _prev.resize(frameValues + sampleValues * _info.numRobots);
+    if (_nextFrame % _encoded.keyframeInterval == 0)
+        std::fill(_prev.begin(), _prev.end(), 0);
+    for (int64_t& v : _prev) {
+        int64_t delta;
+        if (!getVarint(_encoded.data, _offset, delta))
+            return false;
+        v += delta;
+    }
+    dequantizeFrame(_prev.data(), _info.numRobots, _info.dt, frame, samples.data());
+    _nextFrame++;
+    return true;
+}
+
+//---------- Recording the running simulation ----------//
+Replay::Settings& Replay::getSettings() { return settings; }
+
+void Replay::start(const Info& recordingInfo) {
+    pushers = cmp::getFactory(pusherProto)->getClones();
+    info = recordingInfo;
+    info.numRobots = pushers.size();
+    info.dt = atta::Config::getDt();
+    samples.resize(pushers.size());
+    encoder.start(info.numRobots, settings.keyframeInterval, info.dt);
+    closeSpill();
+}
+
+void Replay::record() {
+    if (!settings.enabled || pushers.empty())
+        return;
+    FrameHeader frame;
+    FlightRecorder::capture(pushers, frame, samples.data());
+    encoder.add(frame, samples.data());
+
+    // Move the encoded bytes to disk, so long runs do not keep the whole recording in memory
+    if (encoder.data.size() >= settings.flushSize) {
+        if (!spill)
+            spill = std::tmpfile();
+        if (!spill || std::fwrite(encoder.data.data(), 1, encoder.data.size(), spill) != encoder.data.size()) {
+            LOG_WARN("Replay", "Could not write replay data to a temporary file, recording stopped");
+            pushers.clear();
+            return;
+        }
+        encoder.flushed += encoder.data.size();
+        encoder.data.clear();
+    }
+}
+
+uint32_t Replay::getNumFrames() { return encoder.numFrames; }
+
+bool Replay::write(const std::string& file) {
+    std::ofstream out(file, std::ios::binary);
+    if (!out)
+        return false;
+
+    FileHeader header;
+    header.numRobots = info.numRobots;
+    header.numFrames = encoder.numFrames;
+    header.keyframeInterval = encoder.keyframeInterval;
+    header.dt = info.dt;
+    header.goalX = info.goalX;
+    header.goalY = info.goalY;
+    header.goalRadius = info.goalRadius;
+    header.objectRadius = info.objectRadius;
+    header.pusherRadius = info.pusherRadius;
+    header.mapLength = info.map.size();
+    header.objectLength = info.object.size();
+    header.dataSize = encoder.flushed + encoder.data.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(info.map.data(), info.map.size());
+    out.write(info.object.data(), info.object.size());
+    if (spill) {
+        std::rewind(spill);
+        std::vector<char> buffer(1 << 16);
+        uint64_t copied = 0;
+        while (size_t n = std::fread(buffer.data(), 1, buffer.size(), spill)) {
+            out.write(buffer.data(), n);
+            copied += n;
+        }
+        if (copied != encoder.flushed)
+            return false;
+    }
+    out.write(reinterpret_cast<const char*>(encoder.data.data()), encoder.data.size());
+    out.write(reinterpret_cast<const char*>(encoder.keyframes.data()), encoder.keyframes.size() * sizeof(uint64_t));
+    return bool(out);
+}
+
+void Replay::clear() {
+    pushers.clear();
+    encoder.start(0, settings.keyframeInterval, atta::Config::getDt());
+    closeSpill();
+}
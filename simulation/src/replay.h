@@ -0,0 +1,94 @@
+//--------------------------------------------------
+// Box Pushing
+// replay.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef REPLAY_H
+#define REPLAY_H
+#include "flightRecorder.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Records every step of a run (object, goal and pusher poses, states and vision outputs) in a compact file that can be
+// played back in the UI without running physics or cameras. Frames use the flight recorder layout, they are quantized and
+// delta encoded against the previous frame, with a keyframe every keyframeInterval frames for seeking
+namespace Replay {
+
+using FrameHeader = FlightRecorder::FrameHeader;
+using RobotSample = FlightRecorder::RobotSample;
+
+struct Info {
+    std::string map;
+    std::string object;
+    float dt = 0.0f;
+    float goalX = 0.0f;
+    float goalY = 0.0f;
+    float goalRadius = 0.0f; // Zero if unknown
+    float objectRadius = 0.0f;
+    float pusherRadius = 0.0f;
+    uint32_t numRobots = 0;
+};
+
+// Quantize and delta encode frames. The encoded bytes can be moved out of data as it grows (see flushed)
+class Encoder {
+  public:
+    void start(uint32_t numRobots, uint32_t keyframeInterval, float dt);
+    void add(const FrameHeader& frame, const RobotSample* samples);
+
+    std::vector<uint8_t> data;
+    uint64_t flushed = 0;            // Encoded bytes removed from the front of data
+    std::vector<uint64_t> keyframes; // Data offset of each keyframe (counting the flushed bytes)
+    uint32_t numFrames = 0;
+    uint32_t keyframeInterval = 0;
+    float dt = 0.0f; // Time is stored in steps
+
+  private:
+    std::vector<int64_t> _prev; // Quantized values of the last frame
+    std::vector<int64_t> _curr;
+};
+
+// Recording loaded from a replay file (.bpr) or a flight recorder dump (.bin)
+class Recording {
+  public:
+    bool load(const std::string& file);
+    void clear();
+
+    // Decode a frame. Sequential access only decodes one frame, random access decodes from the previous keyframe
+    bool getFrame(uint32_t idx, FrameHeader& frame, std::vector<RobotSample>& samples);
+    uint32_t getNumFrames() const { return _encoded.numFrames; }
+    const Info& getInfo() const { return _info; }
+    const std::vector<atta::vec2>& getObjectPath() const { return _objectPath; }
+
+  private:
+    bool decodeNext(FrameHeader& frame, std::vector<RobotSample>& samples);
+
+    Info _info;
+    Encoder _encoded;
+    std::vector<atta::vec2> _objectPath; // Object position at each frame
+
+    // Decoder state
+    uint32_t _nextFrame = 0;
+    uint64_t _offset = 0;
+    std::vector<int64_t> _prev;
+};
+
+//---------- Recording the running simulation ----------//
+struct Settings {
+    bool enabled = false;
+    uint32_t keyframeInterval = 100;
+    uint32_t flushSize = 1 << 20; // Encoded bytes kept in memory, then moved to a temporary file until the replay is written
+};
+Settings& getSettings();
+
+// Starts a new recording of the current pushers. Should be called when the simulation starts
+void start(const Info& info);
+// Records the current step. Should be called once per simulation step
+void record();
+uint32_t getNumFrames();
+bool write(const std::string& file);
+void clear();
+
+} // namespace Replay
+
+#endif // REPLAY_H
@@ -0,0 +1,356 @@
+//--------------------------------------------------
+// Box Pushing
+// sensorModel.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "sensorModel.h"
+#include "allocCounter.h"
+#include "common.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <atta/component/components/boxCollider2D.h>
+#include <atta/component/components/circleCollider2D.h>
+#include <atta/component/components/polygonCollider2D.h>
+#include <atta/component/components/relationship.h>
+#include <atta/component/components/transform.h>
+#include <atta/utils/config.h>
+#include <cmath>
+#include <limits>
+
+namespace SensorModel {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+constexpr float cellSize = 0.5f; // Pusher grid cell (m)
+constexpr unsigned maxHits = 16; // Nearest hits kept per panorama column
+
+struct Box {
+    atta::vec2 pos;
+    atta::vec2 half;
+    float c; // Orientation cosine/sine
+    float s;
+    float height;
+};
+
+struct Circle {
+    atta::vec2 pos;
+    float radius;
+    float height;
+};
+
+struct Object {
+    Circle bounds;
+    uint32_t polygonBegin; // Vertices in Scene::polygons, none if the object is a circle
+    uint32_t polygonEnd;
+};
+
+struct Hit {
+    float t;
+    float height;
+    uint8_t pixel; // PusherSensorsComponent::Pixel
+};
+
+// Scene gathered once per step. Containers keep their capacity, so the sensors don't allocate in steady state
+struct Scene {
+    float time = -1.0f;
+    std::pmr::memory_resource* resource = AllocCounter::getResource(AllocCounter::VISION);
+    std::pmr::vector<Box> walls{resource};
+    std::pmr::vector<Object> objects{resource};
+    std::pmr::vector<atta::vec2> polygons{resource};
+    std::pmr::vector<Circle> goals{resource};
+    std::pmr::vector<Circle> pushers{resource};
+    std::pmr::vector<cmp::EntityId> pusherIds{resource};
+    std::pmr::vector<uint8_t> pusherPixels{resource}; // Pushers being a goal are seen with the goal color of their task
+
+    // Pusher grid over the arena (counting sort of the pushers by cell), sized by start
+    atta::vec2 origin;
+    int nx = 0;
+    int ny = 0;
+    std::pmr::vector<uint32_t> cellStart{resource};
+    std::pmr::vector<uint32_t> cellPushers{resource};
+    std::pmr::vector<uint32_t> pusherCells{resource};
+
+    std::pmr::vector<uint32_t> nearby{resource}; // Pushers close to the pusher being updated
+};
+
+Settings settings;
+Scene scene;
+std::vector<cmp::Entity> taskObjects = {object};
+std::vector<cmp::Entity> taskGoals = {goal};
+
+atta::vec2 rotate(atta::vec2 v, float c, float s) { return {c * v.x - s * v.y, s * v.x + c * v.y}; }
+float cross(atta::vec2 a, atta::vec2 b) { return a.x * b.y - a.y * b.x; }
+
+//---------- Ray casting ----------//
+// Distance along the ray to the shape (zero if the origin is inside, infinity if missed)
+float rayCircle(atta::vec2 o, atta::vec2 d, const Circle& circle) {
+    const atta::vec2 oc = o - circle.pos;
+    const float b = dot(oc, d);
+    const float c = dot(oc, oc) - circle.radius * circle.radius;
+    const float disc = b * b - c;
+    if (disc < 0.0f)
+        return inf;
+    const float sq = std::sqrt(disc);
+    if (-b + sq < 0.0f)
+        return inf;
+    return std::max(0.0f, -b - sq);
+}
+
+float rayBox(atta::vec2 o, atta::vec2 d, const Box& box) {
+    // Slab test in the box frame
+    const atta::vec2 lo = rotate(o - box.pos, box.c, -box.s);
+    const atta::vec2 ld = rotate(d, box.c, -box.s);
+    float tMin = 0.0f;
+    float tMax = inf;
+    const float origin[2] = {lo.x, lo.y};
+    const float dir[2] = {ld.x, ld.y};
+    const float half[2] = {box.half.x, box.half.y};
+    for (int i = 0; i < 2; i++) {
+        if (std::abs(dir[i]) < 1e-9f) {
+            if (std::abs(origin[i]) > half[i])
+                return inf;
+            continue;
+        }
+        float t0 = (-half[i] - origin[i]) / dir[i];
+        float t1 = (half[i] - origin[i]) / dir[i];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax)
+            return inf;
+    }
+    return tMin;
+}
+
+float rayPolygon(atta::vec2 o, atta::vec2 d, const atta::vec2* polygon, size_t n) {
+    float best = inf;
+    for (size_t i = 0; i < n; i++) {
+        const atta::vec2 a = polygon[i];
+        const atta::vec2 e = polygon[(i + 1) % n] - a;
+        const float denom = cross(d, e);
+        if (std::abs(denom) < 1e-9f)
+            continue;
+        const atta::vec2 ao = a - o;
+        const float t = cross(ao, e) / denom;
+        const float u = cross(ao, d) / denom;
+        if (t >= 0.0f && u >= 0.0f && u <= 1.0f)
+            best = std::min(best, t);
+    }
+    return best;
+}
+
+float rayObject(atta::vec2 o, atta::vec2 d, const Object& object) {
+    if (object.polygonBegin == object.polygonEnd)
+        return rayCircle(o, d, object.bounds);
+    return rayPolygon(o, d, scene.polygons.data() + object.polygonBegin, object.polygonEnd - object.polygonBegin);
+}
+
+//---------- Scene ----------//
+void gatherScene() {
+    scene.time = atta::Config::getTime();
+
+    // Walls, including the arena border
+    scene.walls.clear();
+    for (cmp::Entity wall : obstacles.get<cmp::Relationship>()->getChildren()) {
+        const cmp::Transform* t = wall.get<cmp::Transform>();
+        const float angle = t->orientation.get2DAngle();
+        scene.walls.push_back({atta::vec2(t->position), atta::vec2(t->scale) * 0.5f, std::cos(angle), std::sin(angle), t->scale.z});
+    }
+
+    // Objects
+    scene.objects.clear();
+    scene.polygons.clear();
+    for (cmp::Entity obj : taskObjects) {
+        const cmp::Transform* ot = obj.get<cmp::Transform>();
+        const float objAngle = ot->orientation.get2DAngle();
+        const float c = std::cos(objAngle);
+        const float s = std::sin(objAngle);
+        const atta::vec2 pos(ot->position);
+        const uint32_t begin = scene.polygons.size();
+        if (obj.get<cmp::BoxCollider2D>()) {
+            const atta::vec2 half = atta::vec2(ot->scale) * 0.5f;
+            for (atta::vec2 p : {atta::vec2(half.x, -half.y), atta::vec2(half.x, half.y), atta::vec2(-half.x, half.y), atta::vec2(-half.x, -half.y)})
+                scene.polygons.push_back(pos + rotate(p, c, s));
+        } else if (const cmp::PolygonCollider2D* polygon = obj.get<cmp::PolygonCollider2D>()) {
+            for (atta::vec2 p : polygon->points)
+                scene.polygons.push_back(pos + rotate(atta::vec2(p.x * ot->scale.x, p.y * ot->scale.y), c, s));
+        }
+        scene.objects.push_back({{pos, ot->scale.x * 0.5f, ot->scale.z}, begin, uint32_t(scene.polygons.size())});
+    }
+
+    // Goals (only visible to the cameras)
+    scene.goals.clear();
+    for (cmp::Entity g : taskGoals) {
+        const cmp::Transform* gt = g.get<cmp::Transform>();
+        scene.goals.push_back({atta::vec2(gt->position), gt->scale.x * 0.5f, gt->scale.z});
+    }
+
+    // Pushers
+    const std::vector<cmp::Entity>& clones = cmp::getFactory(pusherProto)->getClones();
+    scene.pushers.clear();
+    scene.pusherIds.clear();
+    scene.pusherPixels.clear();
+    for (cmp::Entity pusher : clones) {
+        const cmp::Transform* t = pusher.get<cmp::Transform>();
+        scene.pushers.push_back({atta::vec2(t->position), t->scale.x * 0.5f, t->scale.z});
+        scene.pusherIds.push_back(pusher.getId());
+        const PusherComponent* pc = pusher.get<PusherComponent>();
+        const bool isGoal = pc->state == PusherComponent::BE_A_GOAL;
+        scene.pusherPixels.push_back(isGoal ? PusherSensorsComponent::goalPixel(pc->task()) : PusherSensorsComponent::PUSHER);
+    }
+
+    // Pusher grid (pushers outside the arena go to the border cells)
+    const size_t n = scene.pushers.size();
+    std::fill(scene.cellStart.begin(), scene.cellStart.end(), 0);
+    scene.pusherCells.resize(n);
+    scene.cellPushers.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const atta::vec2 p = scene.pushers[i].pos - scene.origin;
+        const int x = std::clamp(int(p.x / cellSize), 0, scene.nx - 1);
+        const int y = std::clamp(int(p.y / cellSize), 0, scene.ny - 1);
+        scene.pusherCells[i] = y * scene.nx + x;
+        scene.cellStart[scene.pusherCells[i]]++;
+    }
+    for (size_t i = 1; i < scene.cellStart.size(); i++)
+        scene.cellStart[i] += scene.cellStart[i - 1]; // End of each cell
+    for (size_t i = 0; i < n; i++)
+        scene.cellPushers[--scene.cellStart[scene.pusherCells[i]]] = i; // Ends become starts
+}
+
+// Collect the other pushers within range of a position
+void gatherNearby(atta::vec2 pos, float range, cmp::EntityId self) {
+    scene.nearby.clear();
+    if (scene.pushers.empty() || scene.nx == 0)
+        return;
+    const int x0 = std::max(0, int((pos.x - range - scene.origin.x) / cellSize));
+    const int y0 = std::max(0, int((pos.y - range - scene.origin.y) / cellSize));
+    const int x1 = std::min(scene.nx - 1, int((pos.x + range - scene.origin.x) / cellSize));
+    const int y1 = std::min(scene.ny - 1, int((pos.y + range - scene.origin.y) / cellSize));
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++) {
+            const int cell = y * scene.nx + x;
+            for (uint32_t i = scene.cellStart[cell]; i < scene.cellStart[cell + 1]; i++) {
+                const uint32_t p = scene.cellPushers[i];
+                const atta::vec2 diff = scene.pushers[p].pos - pos;
+                if (scene.pusherIds[p] != self && dot(diff, diff) <= range * range)
+                    scene.nearby.push_back(p);
+            }
+        }
+}
+
+//---------- Sensors ----------//
+void updateInfrareds(atta::vec2 pos, float heading, float radius, PusherSensorsComponent* sensors) {
+    for (unsigned i = 0; i < PusherSensorsComponent::numIrs; i++) {
+        const float angle = heading + i * 2.0f * M_PI / PusherSensorsComponent::numIrs;
+        const atta::vec2 d(std::cos(angle), std::sin(angle));
+        float t = inf;
+        for (const Object& object : scene.objects)
+            t = std::min(t, rayObject(pos, d, object));
+        for (const Box& wall : scene.walls)
+            t = std::min(t, rayBox(pos, d, wall));
+        for (uint32_t p : scene.nearby)
+            t = std::min(t, rayCircle(pos, d, scene.pushers[p]));
+        sensors->irs[i] = std::clamp(t - radius, 0.0f, sensors->irRange);
+    }
+}
+
+void insertHit(std::array<Hit, maxHits>& hits, unsigned& numHits, Hit hit) {
+    if (hit.t == inf || (numHits == maxHits && hit.t >= hits[numHits - 1].t))
+        return;
+    unsigned i = numHits < maxHits ? numHits++ : numHits - 1;
+    for (; i > 0 && hits[i - 1].t > hit.t; i--)
+        hits[i] = hits[i - 1];
+    hits[i] = hit;
+}
+
+void capturePanorama(atta::vec2 pos, float heading, PusherSensorsComponent* sensors) {
+    constexpr unsigned w = PusherSensorsComponent::panoramaWidth;
+    constexpr unsigned h = PusherSensorsComponent::panoramaHeight;
+    const float focal = h * 0.5f / std::tan(settings.verticalFov * 0.5f);
+    std::array<Hit, maxHits> hits;
+
+    for (unsigned x = 0; x < w; x++) {
+        // Same column to direction mapping as the four camera images side by side (0 to the front, positive to the left)
+        float theta = ((x + 0.5f) / w * 4.0f - 0.5f) * M_PI_2;
+        if (theta > M_PI)
+            theta -= 2.0f * M_PI;
+        const unsigned cam = x / (w / 4);
+        const float cosOffset = std::cos(theta - cam * M_PI_2); // Depth along the camera axis per unit of distance
+        const atta::vec2 d(std::cos(heading + theta), std::sin(heading + theta));
+
+        unsigned numHits = 0;
+        for (unsigned k = 0; k < scene.objects.size(); k++)
+            insertHit(hits, numHits, {rayObject(pos, d, scene.objects[k]), scene.objects[k].bounds.height, PusherSensorsComponent::objectPixel(k)});
+        for (unsigned k = 0; k < scene.goals.size(); k++)
+            insertHit(hits, numHits, {rayCircle(pos, d, scene.goals[k]), scene.goals[k].height, PusherSensorsComponent::goalPixel(k)});
+        for (const Box& wall : scene.walls)
+            insertHit(hits, numHits, {rayBox(pos, d, wall), wall.height, PusherSensorsComponent::WALL});
+        for (uint32_t p : scene.nearby)
+            insertHit(hits, numHits, {rayCircle(pos, d, scene.pushers[p]), scene.pushers[p].height, scene.pusherPixels[p]});
+
+        // Each row sees the nearest hit that is tall enough, or the ground
+        for (unsigned y = 0; y < h; y++) {
+            const float slope = (h * 0.5f - (y + 0.5f)) / focal;
+            const float groundDepth = slope < 0.0f ? settings.cameraHeight / -slope : inf;
+            uint8_t pixel = PusherSensorsComponent::NONE;
+            for (unsigned i = 0; i < numHits; i++) {
+                const float depth = hits[i].t * cosOffset;
+                if (depth > groundDepth)
+                    break;
+                if (settings.cameraHeight + slope * depth <= hits[i].height) {
+                    pixel = hits[i].pixel;
+                    break;
+                }
+            }
+            sensors->panorama[y * w + x] = pixel;
+        }
+    }
+}
+
+} // namespace SensorModel
+
+SensorModel::Settings& SensorModel::getSettings() { return settings; }
+
+void SensorModel::start(atta::vec2 arenaSize) {
+    const size_t numPushers = cmp::getFactory(pusherProto)->getClones().size();
+    scene.pushers.reserve(numPushers);
+    scene.pusherIds.reserve(numPushers);
+    scene.pusherPixels.reserve(numPushers);
+    scene.pusherCells.reserve(numPushers);
+    scene.cellPushers.reserve(numPushers);
+    scene.nearby.reserve(numPushers);
+
+    scene.origin = arenaSize * -0.5f;
+    scene.nx = std::max(1, int(std::ceil(arenaSize.x / cellSize)));
+    scene.ny = std::max(1, int(std::ceil(arenaSize.y / cellSize)));
+    scene.cellStart.assign(size_t(scene.nx) * scene.ny + 1, 0);
+    scene.time = -1.0f;
+}
+
+void SensorModel::setTasks(const std::vector<cmp::Entity>& objects, const std::vector<cmp::Entity>& goals) {
+    taskObjects = objects;
+    taskGoals = goals;
+    scene.time = -1.0f;
+}
+
+void SensorModel::update(cmp::Entity entity, PusherSensorsComponent* sensors) {
+    AllocCounter::Scope allocScope(AllocCounter::VISION);
+    if (scene.time != atta::Config::getTime())
+        gatherScene();
+
+    const cmp::Transform* t = entity.get<cmp::Transform>();
+    const atta::vec2 pos(t->position);
+    const float heading = t->orientation.get2DAngle();
+    const float radius = t->scale.x * 0.5f;
+
+    const float time = atta::Config::getTime();
+    const bool capture = sensors->fps > 0.0f && (sensors->captureTime < 0.0f || time >= sensors->captureTime + 1.0f / sensors->fps - 1e-6f);
+    gatherNearby(pos, (capture ? std::max(settings.pusherViewRange, sensors->irRange) : sensors->irRange) + radius * 2.0f, entity.getId());
+
+    updateInfrareds(pos, heading, radius, sensors);
+    if (capture) {
+        PROFILE_STAGE(Telemetry::CAMERA_CAPTURE);
+        capturePanorama(pos, heading, sensors);
+        sensors->captureTime = time;
+    }
+}
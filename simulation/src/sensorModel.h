@@ -0,0 +1,35 @@
+//--------------------------------------------------
+// Box Pushing
+// sensorModel.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef SENSOR_MODEL_H
+#define SENSOR_MODEL_H
+#include "pusherSensorsComponent.h"
+#include <vector>
+
+// Analytic sensors of the lightweight pushers. The scene (walls, objects, goals and pushers) is gathered once per simulation
+// step; the infrared ring is ray cast on every call and the panorama is ray cast column by column when a capture is due,
+// projecting each hit with a pinhole camera to find the rows it covers
+namespace SensorModel {
+
+struct Settings {
+    float cameraHeight = 0.04f;   // Camera height above the ground (m)
+    float verticalFov = M_PI_2;   // Same as the horizontal field of view of each camera (square pixels)
+    float pusherViewRange = 2.0f; // Farther pushers are a fraction of a pixel and are not drawn (m)
+};
+Settings& getSettings();
+
+// Reserves the scene buffers for the current pushers and builds the pusher grid over the arena (centered at the origin).
+// Should be called when the simulation starts, so the sensors don't allocate while running
+void start(atta::vec2 arenaSize);
+
+// Objects and goals of the tasks (object/goal pairs), by default the scene object and goal
+void setTasks(const std::vector<cmp::Entity>& objects, const std::vector<cmp::Entity>& goals);
+
+// Should be called once per control tick, before the sensors are read
+void update(cmp::Entity entity, PusherSensorsComponent* sensors);
+
+} // namespace SensorModel
+
+#endif // SENSOR_MODEL_H
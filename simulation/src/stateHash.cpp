@@ -0,0 +1,184 @@
+//--------------------------------------------------
+// Box Pushing
+// stateHash.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "stateHash.h"
+#include "common.h"
+#include "pusherComponent.h"
+#include <atta/component/components/rigidBody2D.h>
+#include <atta/component/components/transform.h>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace StateHash {
+
+struct FileHeader {
+    char magic[4] = {'B', 'P', 'S', 'H'};
+    uint32_t version = 1;
+    uint32_t numEntities = 0; // Followed by the entity ids, then numEntities hashes per step
+    uint32_t numSteps = 0;
+};
+
+Mode mode = OFF;
+std::string file;
+std::vector<cmp::Entity> entities; // Object followed by the pushers
+std::vector<uint64_t> hashes;      // numEntities hashes per step
+std::vector<uint64_t> reference;
+uint64_t numSteps = 0;
+uint64_t lastHash = 0;
+Divergence divergence;
+
+// FNV-1a over the bit patterns, so any difference (even in NaN payloads or signed zeros) changes the hash
+class Hasher {
+  public:
+    template <typename T>
+    void add(const T& v) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&v);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            _hash ^= bytes[i];
+            _hash *= 0x100000001b3ull;
+        }
+    }
+    uint64_t get() const { return _hash; }
+
+  private:
+    uint64_t _hash = 0xcbf29ce484222325ull;
+};
+
+void addTransform(Hasher& h, cmp::Entity entity) {
+    cmp::Transform* t = entity.get<cmp::Transform>();
+    h.add(t->position.x);
+    h.add(t->position.y);
+    h.add(t->orientation.get2DAngle());
+}
+
+} // namespace StateHash
+
+void StateHash::start(Mode m, const std::string& f) {
+    mode = m;
+    file = f;
+    entities.clear();
+    hashes.clear();
+    reference.clear();
+    numSteps = 0;
+    lastHash = 0;
+    divergence = {};
+    if (mode == OFF)
+        return;
+
+    entities.push_back(object);
+    for (cmp::Entity pusher : cmp::getFactory(pusherProto)->getClones())
+        entities.push_back(pusher);
+
+    if (mode == VERIFY) {
+        std::ifstream in(file, std::ios::binary);
+        FileHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, FileHeader{}.magic, 4) != 0) {
+            divergence.error = "Could not read reference " + file;
+            return;
+        }
+        std::vector<int32_t> ids(header.numEntities);
+        in.read(reinterpret_cast<char*>(ids.data()), ids.size() * sizeof(int32_t));
+        bool sameEntities = ids.size() == entities.size();
+        for (size_t i = 0; sameEntities && i < ids.size(); i++)
+            sameEntities = ids[i] == entities[i].getId();
+        if (!sameEntities) {
+            divergence.error = "Reference " + file + " was recorded with different entities";
+            return;
+        }
+        reference.resize(uint64_t(header.numSteps) * header.numEntities);
+        in.read(reinterpret_cast<char*>(reference.data()), reference.size() * sizeof(uint64_t));
+        if (!in) {
+            divergence.error = "Reference " + file + " is truncated";
+            reference.clear();
+        }
+    }
+}
+
+void StateHash::onStep() {
+    if (mode == OFF)
+        return;
+
+    // Hash each entity, then combine them into the step hash
+    const size_t first = hashes.size();
+    Hasher stepHasher;
+    for (size_t i = 0; i < entities.size(); i++) {
+        Hasher h;
+        addTransform(h, entities[i]);
+        if (i == 0) {
+            cmp::RigidBody2D* rb = entities[i].get<cmp::RigidBody2D>();
+            h.add(rb->getLinearVelocity().x);
+            h.add(rb->getLinearVelocity().y);
+            h.add(rb->getAngularVelocity());
+        } else {
+            const PusherComponent* p = entities[i].get<PusherComponent>();
+            h.add(p->state);
+            h.add(p->timer);
+            h.add(p->objectDirection);
+            h.add(p->objectDistance);
+            h.add(p->goalDirection);
+            h.add(p->goalDistance);
+            h.add(p->pushDirection);
+            h.add(p->flags);
+            const PusherComponent::Cold& c = PusherComponent::cold(entities[i]);
+            h.add(c.lastFrameTime);
+            h.add(c.beAGoalWait);
+            h.add(c.randomWalkAux);
+        }
+        hashes.push_back(h.get());
+        stepHasher.add(h.get());
+    }
+    lastHash = stepHasher.get();
+
+    // Compare with the reference
+    if (mode == VERIFY && !divergence.diverged && divergence.error.empty()) {
+        if (hashes.size() > reference.size()) {
+            divergence.diverged = true; // Reference run finished earlier
+            divergence.step = numSteps;
+        } else {
+            for (size_t i = 0; i < entities.size(); i++)
+                if (hashes[first + i] != reference[first + i]) {
+                    divergence.diverged = true;
+                    divergence.step = numSteps;
+                    divergence.entity = entities[i].getId();
+                    break;
+                }
+        }
+    }
+    numSteps++;
+}
+
+StateHash::Mode StateHash::getMode() { return mode; }
+
+StateHash::Divergence StateHash::finish() {
+    if (mode == RECORD) {
+        std::ofstream out(file, std::ios::binary);
+        FileHeader header;
+        header.numEntities = entities.size();
+        header.numSteps = numSteps;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (cmp::Entity e : entities) {
+            int32_t id = e.getId();
+            out.write(reinterpret_cast<const char*>(&id), sizeof(id));
+        }
+        out.write(reinterpret_cast<const char*>(hashes.data()), hashes.size() * sizeof(uint64_t));
+        if (!out)
+            divergence.error = "Could not write " + file;
+    } else if (mode == VERIFY && !divergence.diverged && divergence.error.empty() && hashes.size() < reference.size()) {
+        divergence.diverged = true; // Reference run continued for longer
+        divergence.step = numSteps;
+    }
+    mode = OFF;
+    return divergence;
+}
+
+uint64_t StateHash::getLastHash() { return lastHash; }
+
+uint64_t StateHash::hashConfig(const std::string& config) {
+    Hasher h;
+    for (char c : config)
+        h.add(c);
+    return h.get();
+}
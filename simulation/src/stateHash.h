@@ -0,0 +1,45 @@
+//--------------------------------------------------
+// Box Pushing
+// stateHash.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+#include <cstdint>
+#include <string>
+
+// Per-step hash of the world state (object pose and velocity, pusher poses and PusherComponent fields). A run can be
+// recorded as reference and a later run with the same seed verified against it, reporting the first diverging step and
+// entity. Used to check that optimized code paths behave exactly like the reference implementation
+namespace StateHash {
+
+enum Mode : uint32_t {
+    OFF = 0,
+    RECORD,
+    VERIFY,
+    NUM_MODES,
+};
+inline const char* modeNames[] = {"off", "record", "verify"};
+
+struct Divergence {
+    bool diverged = false;
+    uint64_t step = 0;
+    int32_t entity = -1; // Entity id of the first entity with a different hash (the object is reported as its id too)
+    std::string error;   // Set if the reference could not be used
+};
+
+// Starts hashing the current run. In VERIFY mode the reference is loaded from the file
+void start(Mode mode, const std::string& file);
+Mode getMode(); // OFF when no run is being hashed
+// Hashes the current step. Should be called once per simulation step
+void onStep();
+// Finishes the run. In RECORD mode the hashes are written to the file given to start
+Divergence finish();
+
+uint64_t getLastHash();
+// Hash of a configuration string (e.g. a JSON dump), used to tell apart the references of different configurations
+uint64_t hashConfig(const std::string& config);
+
+} // namespace StateHash
+
+#endif // STATE_HASH_H
@@ -0,0 +1,125 @@
+//--------------------------------------------------
+// Box Pushing
+// telemetry.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "telemetry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace Telemetry {
+
+std::array<std::atomic<uint64_t>, NUM_STAGES> stageTime = {};
+std::atomic<bool> newCameraFrame = false;
+thread_local uint64_t* tlsChildTime = nullptr;
+
+uint64_t resetTime = 0;
+uint64_t lastLoopTime = 0;
+uint64_t lastLoopStageTime = 0; // Measured stage time until the last loop
+uint64_t numLoops = 0;
+uint64_t numPhysicsLoops = 0;
+uint64_t physicsLoopTime = 0; // Sum of the remainder on loops without camera frames
+uint64_t maxLoopTime = 0;
+double loopTimeSum = 0.0; // Seconds
+double loopTimeSumSq = 0.0;
+
+} // namespace Telemetry
+
+uint64_t Telemetry::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Telemetry::ScopedStage::ScopedStage(Stage stage) : _stage(stage), _start(now()), _childTime(0), _parentChildTime(tlsChildTime) {
+    tlsChildTime = &_childTime;
+}
+
+Telemetry::ScopedStage::~ScopedStage() {
+    uint64_t elapsed = now() - _start;
+    addStageTime(_stage, elapsed > _childTime ? elapsed - _childTime : 0);
+    if (_parentChildTime)
+        *_parentChildTime += elapsed;
+    tlsChildTime = _parentChildTime;
+}
+
+void Telemetry::addStageTime(Stage stage, uint64_t ns) { stageTime[stage].fetch_add(ns, std::memory_order_relaxed); }
+
+void Telemetry::markCameraFrame() { newCameraFrame.store(true, std::memory_order_relaxed); }
+
+void Telemetry::onLoop() {
+    uint64_t t = now();
+    uint64_t measured = 0;
+    for (const auto& s : stageTime)
+        measured += s.load(std::memory_order_relaxed);
+
+    if (numLoops > 0) {
+        uint64_t loop = t - lastLoopTime;
+        maxLoopTime = std::max(maxLoopTime, loop);
+        loopTimeSum += loop * 1e-9;
+        loopTimeSumSq += (loop * 1e-9) * (loop * 1e-9);
+        uint64_t loopMeasured = measured - lastLoopStageTime;
+        uint64_t remainder = loop > loopMeasured ? loop - loopMeasured : 0;
+        if (!newCameraFrame.exchange(false, std::memory_order_relaxed) || numPhysicsLoops == 0) {
+            numPhysicsLoops++;
+            physicsLoopTime += remainder;
+            addStageTime(PHYSICS, remainder);
+        } else {
+            uint64_t physics = std::min(remainder, physicsLoopTime / numPhysicsLoops);
+            addStageTime(PHYSICS, physics);
+            addStageTime(CAMERA_CAPTURE, remainder - physics);
+        }
+        measured += remainder;
+    }
+
+    lastLoopTime = t;
+    lastLoopStageTime = measured;
+    numLoops++;
+}
+
+void Telemetry::reset() {
+    for (auto& s : stageTime)
+        s.store(0, std::memory_order_relaxed);
+    newCameraFrame = false;
+    resetTime = now();
+    lastLoopTime = 0;
+    lastLoopStageTime = 0;
+    numLoops = 0;
+    numPhysicsLoops = 0;
+    physicsLoopTime = 0;
+    maxLoopTime = 0;
+    loopTimeSum = 0.0;
+    loopTimeSumSq = 0.0;
+}
+
+Telemetry::Report Telemetry::getReport() {
+    Report report;
+    report.wallTime = (now() - resetTime) * 1e-9;
+    report.numLoops = numLoops;
+    for (unsigned i = 0; i < NUM_STAGES; i++)
+        report.stageTime[i] = stageTime[i].load(std::memory_order_relaxed) * 1e-9;
+    report.maxLoopTime = maxLoopTime * 1e-9;
+    if (numLoops > 1) {
+        double n = numLoops - 1; // Number of measured loops
+        double mean = loopTimeSum / n;
+        report.loopTimeStd = std::sqrt(std::max(0.0, loopTimeSumSq / n - mean * mean));
+    }
+    return report;
+}
+
+long Telemetry::getPeakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,64 @@
+//--------------------------------------------------
+// Box Pushing
+// telemetry.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include <array>
+#include <cstdint>
+
+// Profile a scope with atta and also accumulate its (exclusive) time into a telemetry stage
+#define PROFILE_STAGE(stage)                                                                                                                         \
+    PROFILE();                                                                                                                                       \
+    Telemetry::ScopedStage telemetryScopedStage(stage)
+
+namespace Telemetry {
+
+enum Stage : uint32_t {
+    CAMERA_CAPTURE = 0,
+    PROCESS_CAMERAS,
+    FSM_UPDATE,
+    PHYSICS,
+    UI,
+    NUM_STAGES,
+};
+inline const std::array<const char*, NUM_STAGES> stageNames = {"cameraCapture", "processCameras", "fsmUpdate", "physics", "ui"};
+
+uint64_t now(); // Wall-clock time in nanoseconds
+
+// Measures the time spent in a scope. Nested scopes are subtracted from the parent, so each stage gets exclusive time
+class ScopedStage {
+  public:
+    ScopedStage(Stage stage);
+    ~ScopedStage();
+
+  private:
+    Stage _stage;
+    uint64_t _start;
+    uint64_t _childTime;
+    uint64_t* _parentChildTime;
+};
+
+void addStageTime(Stage stage, uint64_t ns);
+void markCameraFrame(); // Should be called when a pusher receives a new camera frame
+
+// Called once per engine loop while the simulation is running. The loop time not covered by the measured stages is spent
+// inside the engine; it is attributed to physics, except on steps with new camera frames, where the excess over the
+// average physics time is attributed to camera capture
+void onLoop();
+
+struct Report {
+    double wallTime = 0.0; // Seconds since reset
+    uint64_t numLoops = 0;
+    std::array<double, NUM_STAGES> stageTime = {}; // Seconds spent in each stage
+    double maxLoopTime = 0.0;                      // Longest engine loop (seconds)
+    double loopTimeStd = 0.0;                      // Standard deviation of the engine loop time (seconds)
+};
+void reset();
+Report getReport();
+long getPeakRssKb();
+
+} // namespace Telemetry
+
+#endif // TELEMETRY_H
@@ -0,0 +1,156 @@
+//--------------------------------------------------
+// Box Pushing
+// traceRecorder.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+#include "traceRecorder.h"
+#include "pusherComponent.h"
+#include <algorithm>
+#include <atomic>
+#include <atta/utils/config.h>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+
+struct ThreadBuffer {
+    std::vector<Event> events; // Ring buffer
+    size_t next = 0;
+    size_t numDropped = 0;
+    bool wrapped = false;
+    uint32_t tid = 0;
+};
+
+std::atomic<bool> enabled = false;
+uint64_t firstStep = 0;
+uint64_t lastStep = 0;
+size_t capacityPerThread = 1 << 16;
+
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer* tlsBuffer = nullptr;
+thread_local const Event* tlsScope = nullptr;
+
+uint64_t now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+ThreadBuffer* getThreadBuffer() {
+    if (!tlsBuffer) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        tlsBuffer = buffers.back().get();
+        tlsBuffer->events.resize(capacityPerThread);
+        tlsBuffer->tid = buffers.size();
+    }
+    return tlsBuffer;
+}
+
+} // namespace Trace
+
+void Trace::configure(bool enabled_, uint64_t firstStep_, uint64_t lastStep_, size_t capacityPerThread_) {
+    firstStep = firstStep_;
+    lastStep = lastStep_;
+    capacityPerThread = std::max<size_t>(capacityPerThread_, 1);
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto& buffer : buffers) {
+            buffer->events.resize(capacityPerThread);
+            buffer->next = 0;
+            buffer->numDropped = 0;
+            buffer->wrapped = false;
+        }
+    }
+    enabled.store(enabled_, std::memory_order_relaxed);
+}
+
+bool Trace::isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+Trace::Scope::Scope(const char* name) : _active(false), _parent(tlsScope) {
+    if (enabled.load(std::memory_order_relaxed))
+        begin(name, _parent ? _parent->entity : -1, _parent ? _parent->state : -1);
+}
+
+Trace::Scope::Scope(const char* name, int32_t entity, int32_t state) : _active(false), _parent(tlsScope) {
+    if (enabled.load(std::memory_order_relaxed))
+        begin(name, entity, state);
+}
+
+void Trace::Scope::begin(const char* name, int32_t entity, int32_t state) {
+    uint64_t step = std::lround(atta::Config::getTime() / atta::Config::getDt());
+    if (step < firstStep || step > lastStep)
+        return;
+    _active = true;
+    _event = {name, now(), 0, step, entity, state};
+    tlsScope = &_event;
+}
+
+Trace::Scope::~Scope() {
+    if (!_active)
+        return;
+    _event.end = now();
+    tlsScope = _parent;
+
+    ThreadBuffer* buffer = getThreadBuffer();
+    if (buffer->next == buffer->events.size()) {
+        buffer->next = 0;
+        buffer->wrapped = true;
+    }
+    if (buffer->wrapped)
+        buffer->numDropped++;
+    buffer->events[buffer->next++] = _event;
+}
+
+size_t Trace::getNumEvents() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    size_t num = 0;
+    for (const auto& buffer : buffers)
+        num += buffer->wrapped ? buffer->events.size() : buffer->next;
+    return num;
+}
+
+size_t Trace::getNumDropped() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    size_t num = 0;
+    for (const auto& buffer : buffers)
+        num += buffer->numDropped;
+    return num;
+}
+
+bool Trace::write(const std::string& file) {
+    std::ofstream out(file);
+    if (!out)
+        return false;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        size_t size = buffer->wrapped ? buffer->events.size() : buffer->next;
+        size_t start = buffer->wrapped ? buffer->next : 0;
+        for (size_t i = 0; i < size; i++) {
+            const Event& e = buffer->events[(start + i) % buffer->events.size()];
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"" << e.name << "\",\"cat\":\"pusher\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid;
+            out << ",\"ts\":" << e.begin / 1000.0 << ",\"dur\":" << (e.end - e.begin) / 1000.0;
+            out << ",\"args\":{\"step\":" << e.step << ",\"entity\":" << e.entity;
+            if (e.state >= 0 && e.state < int32_t(PusherComponent::stateNames.size()))
+                out << ",\"state\":\"" << PusherComponent::stateNames[e.state] << "\"";
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+    return bool(out);
+}
+
+void Trace::clear() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto& buffer : buffers) {
+        buffer->next = 0;
+        buffer->numDropped = 0;
+        buffer->wrapped = false;
+    }
+}
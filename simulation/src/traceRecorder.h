@@ -0,0 +1,55 @@
+//--------------------------------------------------
+// Box Pushing
+// traceRecorder.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Record the current scope in the trace. Arguments: name[, entity id, pusher state]. When entity and state are not
+// provided, they are inherited from the enclosing trace scope
+#define TRACE_SCOPE(...) Trace::Scope traceScope(__VA_ARGS__)
+
+namespace Trace {
+
+struct Event {
+    const char* name;
+    uint64_t begin; // Wall-clock time in nanoseconds
+    uint64_t end;
+    uint64_t step; // Simulation step
+    int32_t entity;
+    int32_t state;
+};
+
+// Record only scopes that start in the steps [firstStep, lastStep]. Each thread keeps a ring buffer with capacityPerThread
+// events, older events are overwritten when it is full
+void configure(bool enabled, uint64_t firstStep, uint64_t lastStep, size_t capacityPerThread = 1 << 16);
+bool isEnabled();
+
+class Scope {
+  public:
+    Scope(const char* name);
+    Scope(const char* name, int32_t entity, int32_t state);
+    ~Scope();
+
+  private:
+    void begin(const char* name, int32_t entity, int32_t state);
+
+    Event _event;
+    bool _active;
+    const Event* _parent;
+};
+
+size_t getNumEvents();
+size_t getNumDropped();
+// Write the recorded events in the Chrome trace event format (also loaded by Perfetto). Must not be called while the
+// simulation is running
+bool write(const std::string& file);
+void clear();
+
+} // namespace Trace
+
+#endif // TRACE_RECORDER_H
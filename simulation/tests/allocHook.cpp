@@ -0,0 +1,59 @@
+//--------------------------------------------------
+// Box Pushing
+// allocHook.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+// Global operator new/delete replacement, built as a shared library to be preloaded (LD_PRELOAD) into the simulator. The
+// scripts are loaded as shared libraries after the C++ runtime, so only a preloaded replacement sees every allocation of the
+// process (scripts, atta and the standard library). Each allocation calls the hook installed by AllocCounter, which counts
+// it for the subsystem of the current AllocCounter::Scope
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<void (*)()> hook = nullptr;
+
+void* allocate(size_t size, size_t alignment) {
+    if (void (*h)() = hook.load(std::memory_order_relaxed))
+        h();
+    if (size == 0)
+        size = 1;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* allocateOrThrow(size_t size, size_t alignment) {
+    if (void* p = allocate(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+extern "C" __attribute__((visibility("default"))) void boxPushingSetAllocHook(void (*h)()) { hook.store(h); }
+
+void* operator new(size_t size) { return allocateOrThrow(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return allocateOrThrow(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t al) { return allocateOrThrow(size, size_t(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return allocateOrThrow(size, size_t(al)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, size_t(al)); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, size_t(al)); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
@@ -0,0 +1,70 @@
+//--------------------------------------------------
+// Box Pushing
+// allocHookTest.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+// Checks that the preloaded alloc_hook library counts the heap allocations of each AllocCounter::Scope, including the ones
+// that do not go through the subsystem resources, and that allocations outside of scopes are ignored
+#include "allocCounter.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+int numFailures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        numFailures++;
+    }
+}
+
+int main() {
+    AllocCounter::reset(0);
+    check(AllocCounter::isHeapHookInstalled(), "alloc_hook is not preloaded");
+
+    // Untagged allocations are ignored
+    auto untagged = std::make_unique<int>(1);
+    AllocCounter::onStep();
+    check(AllocCounter::isSteadyStateAllocationFree(), "allocation outside of a scope was counted");
+
+    // Plain allocations in a scope are counted for it, and nested scopes restore the previous tag
+    {
+        AllocCounter::Scope control(AllocCounter::CONTROL);
+        std::vector<int> v(16);
+        {
+            AllocCounter::Scope vision(AllocCounter::VISION);
+            std::string s(64, 'x');
+        }
+        auto p = std::make_unique<double>(2.0);
+    }
+    AllocCounter::onStep();
+    check(AllocCounter::getReport(AllocCounter::CONTROL).lastStep == 2, "control allocations were not counted");
+    check(AllocCounter::getReport(AllocCounter::VISION).lastStep == 1, "nested vision allocation was not counted");
+
+    // Allocations through a resource are counted once
+    {
+        AllocCounter::Scope vision(AllocCounter::VISION);
+        std::pmr::vector<int> v{AllocCounter::getResource(AllocCounter::VISION)};
+        v.resize(16);
+    }
+    AllocCounter::onStep();
+    check(AllocCounter::getReport(AllocCounter::VISION).lastStep == 1, "resource allocation was not counted once");
+
+    // Reused capacity does not allocate
+    std::pmr::vector<int> reused{AllocCounter::getResource(AllocCounter::CONTROL)};
+    reused.reserve(64);
+    AllocCounter::reset(0);
+    for (int step = 0; step < 100; step++) {
+        AllocCounter::Scope control(AllocCounter::CONTROL);
+        reused.assign(step % 64, step);
+        AllocCounter::onStep();
+    }
+    check(AllocCounter::isSteadyStateAllocationFree(), "reused capacity was counted");
+
+    if (numFailures)
+        std::printf("%d checks failed\n", numFailures);
+    return numFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
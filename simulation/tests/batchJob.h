@@ -0,0 +1,41 @@
+//--------------------------------------------------
+// Box Pushing
+// batchJob.h
+// Date: 2026-10-19
+//--------------------------------------------------
+#ifndef BATCH_JOB_H
+#define BATCH_JOB_H
+#include "nlohmann/json.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Runs a batch job of the simulation (see BOX_PUSHING_JOB in projectScript.cpp) in a new process. The job, its result and
+// the simulation log are written to directory/name.json, name.result.json and name.log. env is put before the command (e.g.
+// "LD_PRELOAD=..."). Returns the result, or a discarded value if the job did not complete
+inline nlohmann::json runBatchJob(const std::string& command, nlohmann::json job, const std::filesystem::path& directory,
+                                  const std::string& name, const std::string& env = "") {
+    namespace fs = std::filesystem;
+    const fs::path jobFile = directory / (name + ".json");
+    const fs::path outputFile = directory / (name + ".result.json");
+    const fs::path logFile = directory / (name + ".log");
+    job["output"] = outputFile.string();
+    std::ofstream(jobFile) << job.dump(4);
+
+    std::error_code ec;
+    fs::remove(outputFile, ec);
+    std::string run = env + " BOX_PUSHING_JOB=\"" + jobFile.string() + "\" " + command + " > \"" + logFile.string() + "\" 2>&1";
+    std::system(run.c_str());
+
+    std::ifstream in(outputFile);
+    nlohmann::json result = nlohmann::json::parse(in, nullptr, false);
+    if (!result.is_object() || !result.value("complete", false) || !result.contains("experiments")) {
+        std::printf("FAIL: job %s did not complete, see %s\n", name.c_str(), logFile.string().c_str());
+        return nlohmann::json(nlohmann::json::value_t::discarded);
+    }
+    return result;
+}
+
+#endif // BATCH_JOB_H
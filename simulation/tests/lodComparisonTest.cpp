@@ -0,0 +1,140 @@
+//--------------------------------------------------
+// Box Pushing
+// lodComparisonTest.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+// Runs the same batch jobs of the real simulation with the control-rate level of detail (Lod) off and on, and fails if the
+// success rates differ significantly (two-proportion z-test) or by more than the allowed difference. Each job runs the
+// paper maps with one seed, the jobs of both settings use the same seeds and run in parallel
+//
+// Usage: lod_comparison_test <simulation command> [-n seeds] [-j jobs] [-t timeout] [-d max difference]
+// Should run from the simulation directory, e.g. lod_comparison_test "atta object-transportation.atta" -n 8
+#include "batchJob.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+const char* maps[] = {"reference", "middle", "corner", "2-corners"};
+
+struct Options {
+    std::string command;
+    unsigned numSeeds = 8;
+    unsigned numJobs = std::max(1u, std::thread::hardware_concurrency());
+    float timeout = 600.0f;
+    double maxDifference = 0.15; // Maximum success rate difference
+    double z = 1.96;             // Two-sided 95% significance
+};
+
+struct Outcome {
+    unsigned numRuns = 0;
+    unsigned numSuccesses = 0;
+    double timeSum = 0.0; // Of the successful runs
+};
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc)
+            opt.numSeeds = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "-j" && i + 1 < argc)
+            opt.numJobs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "-t" && i + 1 < argc)
+            opt.timeout = std::atof(argv[++i]);
+        else if (arg == "-d" && i + 1 < argc)
+            opt.maxDifference = std::atof(argv[++i]);
+        else
+            opt.command = arg;
+    }
+    if (opt.command.empty()) {
+        std::printf("Usage: %s <simulation command> [-n seeds] [-j jobs] [-t timeout] [-d max difference]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const fs::path directory = fs::temp_directory_path();
+
+    // Job i runs seed i / 2, with Lod on for odd i
+    std::vector<json> results(opt.numSeeds * 2);
+    std::atomic<size_t> next = 0;
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < std::min<size_t>(opt.numJobs, results.size()); w++)
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < results.size(); i = next++) {
+                const bool lod = i % 2;
+                json job = {};
+                job["seed"] = i / 2;
+                job["lod"] = lod;
+                job["experiments"] = json::array();
+                for (const char* map : maps)
+                    job["experiments"].push_back({{"map", map}, {"object", "square"}, {"numRobots", 20}, {"timeout", opt.timeout}});
+                results[i] = runBatchJob(opt.command, job, directory, "lod_test-seed_" + std::to_string(i / 2) + (lod ? "-lod" : ""));
+            }
+        });
+    for (std::thread& w : workers)
+        w.join();
+
+    // Per map and total outcome of each setting
+    int numFailures = 0;
+    std::vector<Outcome> outcomes((std::size(maps) + 1) * 2);
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].is_discarded()) {
+            numFailures++;
+            continue;
+        }
+        const json& experiments = results[i]["experiments"];
+        for (size_t m = 0; m < std::size(maps) && m < experiments.size(); m++) {
+            for (const json& rep : experiments[m]["repetitions"]) {
+                for (size_t o : {m * 2 + i % 2, std::size(maps) * 2 + i % 2}) {
+                    outcomes[o].numRuns++;
+                    if (rep.value("success", false)) {
+                        outcomes[o].numSuccesses++;
+                        outcomes[o].timeSum += rep.value("time", 0.0);
+                    }
+                }
+            }
+        }
+    }
+
+    std::printf("%-12s %14s %14s %12s %12s\n", "map", "success off", "success on", "time off", "time on");
+    for (size_t m = 0; m <= std::size(maps); m++) {
+        const Outcome& off = outcomes[m * 2];
+        const Outcome& on = outcomes[m * 2 + 1];
+        std::printf("%-12s %6u/%-7u %6u/%-7u %12.1f %12.1f\n", m < std::size(maps) ? maps[m] : "total", off.numSuccesses, off.numRuns,
+                    on.numSuccesses, on.numRuns, off.numSuccesses ? off.timeSum / off.numSuccesses : NAN,
+                    on.numSuccesses ? on.timeSum / on.numSuccesses : NAN);
+    }
+
+    // Compare the total success rates
+    const Outcome& off = outcomes[std::size(maps) * 2];
+    const Outcome& on = outcomes[std::size(maps) * 2 + 1];
+    if (off.numRuns == 0 || on.numRuns == 0) {
+        std::printf("FAIL: no runs to compare\n");
+        return EXIT_FAILURE;
+    }
+    const double pOff = double(off.numSuccesses) / off.numRuns;
+    const double pOn = double(on.numSuccesses) / on.numRuns;
+    const double pooled = double(off.numSuccesses + on.numSuccesses) / (off.numRuns + on.numRuns);
+    const double se = std::sqrt(pooled * (1.0 - pooled) * (1.0 / off.numRuns + 1.0 / on.numRuns));
+    const double zScore = se > 0.0 ? (pOn - pOff) / se : 0.0;
+    std::printf("Success rate off %.3f, on %.3f, z %.2f\n", pOff, pOn, zScore);
+    if (std::abs(zScore) > opt.z) {
+        std::printf("FAIL: success rates differ significantly\n");
+        numFailures++;
+    }
+    if (std::abs(pOn - pOff) > opt.maxDifference) {
+        std::printf("FAIL: success rates differ by more than %.2f\n", opt.maxDifference);
+        numFailures++;
+    }
+
+    if (numFailures)
+        std::printf("%d checks failed\n", numFailures);
+    return numFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
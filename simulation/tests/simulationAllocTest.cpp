@@ -0,0 +1,78 @@
+//--------------------------------------------------
+// Box Pushing
+// simulationAllocTest.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+// Runs short batch jobs of the real simulation with the alloc_hook library preloaded, so every heap allocation made inside
+// the control step (PusherController, processCameras/processPanorama, sensor model, batched actuation and the teleop leader)
+// is counted, and fails if any subsystem allocated after the warm-up steps. One job uses the camera pushers and another the
+// lightweight pushers, each with the three controller scripts
+//
+// Usage: simulation_alloc_test <alloc_hook library> <simulation command>
+// Should run from the simulation directory, e.g. simulation_alloc_test build/tests/liballoc_hook.so "atta object-transportation.atta"
+#include "batchJob.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+const char* scripts[] = {"PusherPaperScript", "PusherScript", "PusherTeleopScript"};
+
+// Returns the number of failed experiments
+int runJob(const fs::path& hook, const std::string& command, const fs::path& directory, bool lightweight) {
+    const std::string name = lightweight ? "lightweight" : "cameras";
+    json job = {};
+    job["seed"] = 0;
+    job["lightweightPushers"] = lightweight;
+    job["experiments"] = json::array();
+    for (const char* script : scripts)
+        job["experiments"].push_back({{"map", "reference"}, {"object", "square"}, {"numRobots", 20}, {"timeout", 30.0f}, {"script", script}});
+
+    std::printf("%s pushers\n", name.c_str());
+    json result = runBatchJob(command, job, directory, "alloc_test-" + name, "LD_PRELOAD=\"" + hook.string() + "\"");
+    if (result.is_discarded())
+        return 1;
+
+    int numFailures = 0;
+    const json& experiments = result["experiments"];
+    for (size_t i = 0; i < std::size(scripts); i++) {
+        if (i >= experiments.size() || experiments[i]["repetitions"].empty()) {
+            std::printf("FAIL: %s has no results\n", scripts[i]);
+            numFailures++;
+            continue;
+        }
+        const json& performance = experiments[i]["repetitions"][0]["performance"];
+        const bool heapHook = performance.value("heapHook", false);
+        const bool allocationFree = performance.value("allocationFree", false);
+        std::printf("  %-18s heap hook %s, steady state allocations:", scripts[i], heapHook ? "yes" : "no");
+        for (const auto& [subsystem, allocs] : performance["allocations"].items())
+            std::printf(" %s %llu", subsystem.c_str(), allocs.value("steadyState", 0ull));
+        std::printf("\n");
+        if (!heapHook) {
+            std::printf("FAIL: the simulation did not find the preloaded hook\n");
+            numFailures++;
+        } else if (!allocationFree) {
+            std::printf("FAIL: %s allocated in steady state\n", scripts[i]);
+            numFailures++;
+        }
+    }
+    return numFailures;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::printf("Usage: %s <alloc_hook library> <simulation command>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const fs::path hook = fs::absolute(argv[1]);
+    const std::string command = argv[2];
+    const fs::path directory = fs::temp_directory_path();
+
+    int numFailures = runJob(hook, command, directory, false) + runJob(hook, command, directory, true);
+    if (numFailures)
+        std::printf("%d checks failed\n", numFailures);
+    return numFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
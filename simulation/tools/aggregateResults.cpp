@@ -0,0 +1,350 @@
+//--------------------------------------------------
+// Box Pushing
+// aggregateResults.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+// Aggregate the experiment result files written by runExperiments (experiments/*_rep.json) into one summary CSV with a
+// row per configuration. Files are parsed in parallel with the SAX interface, so the object paths are reduced to their
+// length while parsing instead of being stored
+//
+// Usage: aggregate_results [-j threads] [-o summary.csv] <experiments directory | result files...>
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+//---------- Parsed data ----------//
+struct Repetition {
+    bool success = false;
+    double time = NAN;
+    double distance = NAN;
+    double pathLength = 0.0;
+    double startX = NAN; // First object position
+    double startY = NAN;
+    double pathEfficiency = NAN; // Computed by the simulation when the optimal path is known
+    double throughput = NAN;     // Objects delivered per simulated hour (several object/goal pairs)
+    double firstChainTime = NAN; // First connected sub-goal chain
+    double chainBreakages = NAN;
+};
+
+struct ResultFile {
+    std::string configuration; // File name without the number of repetitions
+    std::string controller;
+    std::string map;
+    int64_t numRobots = 0;
+    double goalX = NAN;
+    double goalY = NAN;
+    double minObjectGoalDist = 0.0;
+    double optimalPathLength = NAN; // Only in results that contain it
+    std::vector<Repetition> repetitions;
+    std::string error;
+};
+
+//---------- SAX handler ----------//
+class ResultHandler : public nlohmann::json_sax<json> {
+  public:
+    ResultHandler(ResultFile& result) : _result(result) {}
+
+    bool null() override { return scalar(NAN); }
+    bool boolean(bool v) override {
+        if (is({"repetitions", "#", "success"}))
+            _result.repetitions.back().success = v;
+        return scalar(NAN);
+    }
+    bool number_integer(number_integer_t v) override { return number(v); }
+    bool number_unsigned(number_unsigned_t v) override { return number(v); }
+    bool number_float(number_float_t v, const string_t&) override { return number(v); }
+    bool string(string_t& v) override {
+        if (is({"config", "controller"}))
+            _result.controller = v;
+        else if (is({"config", "map", "name"}))
+            _result.map = v;
+        return scalar(NAN);
+    }
+    bool binary(binary_t&) override { return scalar(NAN); }
+
+    bool start_object(std::size_t) override {
+        if (is({"repetitions", "#"}))
+            _result.repetitions.emplace_back();
+        _stack.push_back({false, "", 0});
+        return true;
+    }
+    bool key(string_t& k) override {
+        _stack.back().key = k;
+        return true;
+    }
+    bool end_object() override {
+        _stack.pop_back();
+        return endValue();
+    }
+    bool start_array(std::size_t) override {
+        _stack.push_back({true, "", 0});
+        return true;
+    }
+    bool end_array() override {
+        _stack.pop_back();
+        // Accumulate path length when a point is finished
+        if (is({"repetitions", "#", "path", "#"})) {
+            Repetition& rep = _result.repetitions.back();
+            if (std::isnan(rep.startX)) {
+                rep.startX = _point[0];
+                rep.startY = _point[1];
+            } else
+                rep.pathLength += std::hypot(_point[0] - _lastPoint[0], _point[1] - _lastPoint[1]);
+            _lastPoint[0] = _point[0];
+            _lastPoint[1] = _point[1];
+        }
+        return endValue();
+    }
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) override {
+        _result.error = "parse error at byte " + std::to_string(position) + ": " + e.what();
+        return false;
+    }
+
+  private:
+    struct Level {
+        bool array;
+        std::string key; // Current key (objects)
+        size_t index;    // Current index (arrays)
+    };
+
+    // Check if the current value is at the given path ("#" matches any array index)
+    bool is(std::initializer_list<const char*> path) const {
+        if (path.size() != _stack.size())
+            return false;
+        size_t i = 0;
+        for (const char* p : path) {
+            const Level& l = _stack[i++];
+            if (l.array ? std::strcmp(p, "#") != 0 : l.key != p)
+                return false;
+        }
+        return true;
+    }
+
+    bool number(double v) {
+        if (is({"repetitions", "#", "path", "#", "#"})) {
+            size_t idx = _stack.back().index;
+            if (idx < 2)
+                _point[idx] = v;
+        } else if (is({"repetitions", "#", "time"}))
+            _result.repetitions.back().time = v;
+        else if (is({"repetitions", "#", "distance"}))
+            _result.repetitions.back().distance = v;
+        else if (is({"repetitions", "#", "pathEfficiency"}))
+            _result.repetitions.back().pathEfficiency = v;
+        else if (is({"repetitions", "#", "throughput"}))
+            _result.repetitions.back().throughput = v;
+        else if (is({"repetitions", "#", "subGoalChain", "firstChainTime"}))
+            _result.repetitions.back().firstChainTime = v;
+        else if (is({"repetitions", "#", "subGoalChain", "breakages"}))
+            _result.repetitions.back().chainBreakages = v;
+        else if (is({"config", "numRobots"}))
+            _result.numRobots = v;
+        else if (is({"config", "minObjectGoalDist"}))
+            _result.minObjectGoalDist = v;
+        else if (is({"config", "optimalPathLength"}))
+            _result.optimalPathLength = v;
+        else if (is({"config", "map", "goal", "#"}))
+            (_stack.back().index == 0 ? _result.goalX : _result.goalY) = v;
+        return scalar(v);
+    }
+
+    bool scalar(double) { return endValue(); }
+
+    // A value finished, advance the index of the enclosing array
+    bool endValue() {
+        if (!_stack.empty() && _stack.back().array)
+            _stack.back().index++;
+        return true;
+    }
+
+    ResultFile& _result;
+    std::vector<Level> _stack;
+    double _point[2] = {0.0, 0.0};
+    double _lastPoint[2] = {0.0, 0.0};
+};
+
+ResultFile parseFile(const fs::path& file) {
+    ResultFile result;
+
+    // <initialPos>_init-<map>-<script>-<numRobots>_robots-<object>[-<numTasks>_tasks]-<numRepetitions>_rep.json
+    std::string stem = file.stem().string();
+    size_t dash = stem.rfind('-');
+    result.configuration = dash == std::string::npos ? stem : stem.substr(0, dash);
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        result.error = "could not open file";
+        return result;
+    }
+    ResultHandler handler(result);
+    json::sax_parse(in, &handler);
+    return result;
+}
+
+//---------- Statistics ----------//
+double quantile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty())
+        return NAN;
+    double pos = q * (sorted.size() - 1);
+    size_t i = pos;
+    double frac = pos - i;
+    return i + 1 < sorted.size() ? sorted[i] * (1.0 - frac) + sorted[i + 1] * frac : sorted[i];
+}
+
+double mean(const std::vector<double>& values) {
+    if (values.empty())
+        return NAN;
+    double sum = 0.0;
+    for (double v : values)
+        sum += v;
+    return sum / values.size();
+}
+
+struct Summary {
+    ResultFile info; // Configuration of the first file
+    size_t numFiles = 0;
+    size_t numRepetitions = 0;
+    size_t numSuccesses = 0;
+    std::vector<double> successTimes;
+    std::vector<double> distances;
+    std::vector<double> efficiencies; // Optimal path length / object path length (successful repetitions)
+    std::vector<double> throughputs;
+    std::vector<double> firstChainTimes;
+    std::vector<double> chainBreakages;
+};
+
+void accumulate(Summary& s, const ResultFile& r) {
+    if (s.numFiles++ == 0) {
+        s.info = r;
+        s.info.repetitions.clear();
+    }
+    for (const Repetition& rep : r.repetitions) {
+        s.numRepetitions++;
+        if (!std::isnan(rep.distance))
+            s.distances.push_back(rep.distance);
+        if (!std::isnan(rep.throughput))
+            s.throughputs.push_back(rep.throughput);
+        if (!std::isnan(rep.firstChainTime))
+            s.firstChainTimes.push_back(rep.firstChainTime);
+        if (!std::isnan(rep.chainBreakages))
+            s.chainBreakages.push_back(rep.chainBreakages);
+        if (!rep.success)
+            continue;
+        s.numSuccesses++;
+        s.successTimes.push_back(rep.time);
+
+        if (!std::isnan(rep.pathEfficiency)) {
+            s.efficiencies.push_back(rep.pathEfficiency);
+            continue;
+        }
+
+        // Without the optimal path length, use the straight line from the start to the goal region
+        double optimal = r.optimalPathLength;
+        if (std::isnan(optimal) && !std::isnan(rep.startX) && !std::isnan(r.goalX))
+            optimal = std::max(0.0, std::hypot(r.goalX - rep.startX, r.goalY - rep.startY) - r.minObjectGoalDist);
+        if (!std::isnan(optimal) && rep.pathLength > 0.0)
+            s.efficiencies.push_back(optimal / rep.pathLength);
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::string output;
+    std::vector<fs::path> inputs;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc)
+            numThreads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if (arg == "-h" || arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [-j threads] [-o summary.csv] <experiments directory | result files...>\n";
+            return 0;
+        } else
+            inputs.push_back(arg);
+    }
+    if (inputs.empty())
+        inputs.push_back("experiments");
+
+    // Collect result files
+    std::vector<fs::path> files;
+    for (const fs::path& input : inputs) {
+        std::error_code ec;
+        if (fs::is_directory(input, ec)) {
+            for (const fs::directory_entry& entry : fs::directory_iterator(input, ec)) {
+                std::string name = entry.path().filename().string();
+                if (entry.is_regular_file() && name.size() > 9 && name.compare(name.size() - 9, 9, "_rep.json") == 0)
+                    files.push_back(entry.path());
+            }
+        } else
+            files.push_back(input);
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::cerr << "No result files found\n";
+        return 1;
+    }
+
+    // Parse in parallel
+    std::vector<ResultFile> results(files.size());
+    std::atomic<size_t> next = 0;
+    std::vector<std::thread> workers;
+    numThreads = std::min<size_t>(numThreads, files.size());
+    for (unsigned t = 0; t < numThreads; t++)
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < files.size(); i = next++)
+                results[i] = parseFile(files[i]);
+        });
+    for (std::thread& w : workers)
+        w.join();
+
+    // Group by configuration
+    std::map<std::string, Summary> summaries;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!results[i].error.empty()) {
+            std::cerr << "Skipping " << files[i].string() << ": " << results[i].error << "\n";
+            continue;
+        }
+        accumulate(summaries[results[i].configuration], results[i]);
+    }
+
+    // Write CSV
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "Could not open " << output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+    out << "configuration,map,controller,numRobots,files,repetitions,successes,successRate,timeP10,timeP25,timeMedian,timeP75,timeP90,"
+           "meanFinalDistance,meanPathEfficiency,meanThroughput,firstChainTimeMedian,meanChainBreakages\n";
+    for (auto& [configuration, s] : summaries) {
+        std::sort(s.successTimes.begin(), s.successTimes.end());
+        std::sort(s.firstChainTimes.begin(), s.firstChainTimes.end());
+        double successRate = s.numRepetitions ? double(s.numSuccesses) / s.numRepetitions : NAN;
+        char values[512];
+        std::snprintf(values, sizeof(values), "%zu,%zu,%zu,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%.4f,%.4f,%.3f,%.3f,%.3f", s.numFiles, s.numRepetitions,
+                      s.numSuccesses, successRate, quantile(s.successTimes, 0.1), quantile(s.successTimes, 0.25), quantile(s.successTimes, 0.5),
+                      quantile(s.successTimes, 0.75), quantile(s.successTimes, 0.9), mean(s.distances), mean(s.efficiencies), mean(s.throughputs),
+                      quantile(s.firstChainTimes, 0.5), mean(s.chainBreakages));
+        out << configuration << "," << s.info.map << "," << s.info.controller << "," << s.info.numRobots << "," << values << "\n";
+    }
+
+    std::cerr << "Aggregated " << files.size() << " files into " << summaries.size() << " configurations\n";
+    return 0;
+}
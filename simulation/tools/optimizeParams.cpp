@@ -0,0 +1,267 @@
+//--------------------------------------------------
+// Box Pushing
+// optimizeParams.cpp
+// Date: 2026-10-19
+//--------------------------------------------------
+// Tune the controller parameters (ControllerParams) to minimize the completion time over a set of maps. Each generation
+// samples candidates around the best parameters so far and races them: candidates are evaluated block by block (one block
+// runs every map with the same seed for all candidates) and are dropped once they are significantly worse than the best
+// one (one-sided paired test). Evaluations are headless simulations started in parallel, each running a batch job file
+// (see BOX_PUSHING_JOB in projectScript.cpp) and exiting when done
+//
+// Usage: optimize_params -c <simulation command> [-j jobs] [-n candidates] [-g generations] [-b blocks] [-m map,map,...]
+//                        [-r robots] [-t timeout] [-s seed] [-o directory]
+#include "controllerParams.h"
+#include "nlohmann/json.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+struct Options {
+    std::string command;
+    unsigned numJobs = std::max(1u, std::thread::hardware_concurrency());
+    unsigned numCandidates = 12;
+    unsigned numGenerations = 5;
+    unsigned maxBlocks = 6;
+    unsigned minBlocks = 2;          // Blocks before a candidate can be dropped
+    float z = 1.645f;                // One-sided 95% normal quantile
+    float failurePenalty = 2.0f;     // Cost of a failed run, relative to the timeout
+    float initialStep = 0.3f;        // Sampling standard deviation relative to the parameter range
+    float stepDecay = 0.7f;          // Step multiplier per generation
+    std::vector<std::string> maps = {"reference", "middle", "corner", "2-corners"};
+    std::string object = "square";
+    int numRobots = 20;
+    float timeout = 600.0f;
+    unsigned seed = 0;
+    fs::path directory = "optimization";
+};
+
+struct Candidate {
+    ControllerParams::Params params;
+    std::vector<double> costs; // Per evaluated run, block major (same order for every candidate)
+    bool alive = true;
+    double mean() const {
+        double sum = 0.0;
+        for (double c : costs)
+            sum += c;
+        return costs.empty() ? INFINITY : sum / costs.size();
+    }
+};
+
+//---------- Evaluation ----------//
+// Run the block of a candidate and return the cost of each map
+std::vector<double> evaluate(const Options& opt, const Candidate& candidate, const fs::path& jobFile, unsigned block) {
+    const double failureCost = opt.timeout * opt.failurePenalty;
+    std::vector<double> costs(opt.maps.size(), failureCost);
+
+    fs::path outputFile = fs::path(jobFile).replace_extension(".result.json");
+    json job = {};
+    job["params"] = ControllerParams::toJson(candidate.params);
+    job["seed"] = opt.seed + block;
+    job["experiments"] = json::array();
+    for (const std::string& map : opt.maps)
+        job["experiments"].push_back({{"map", map}, {"object", opt.object}, {"numRobots", opt.numRobots}, {"timeout", opt.timeout}});
+    job["output"] = fs::absolute(outputFile).string();
+    std::ofstream(jobFile) << job.dump(4);
+
+    std::error_code ec;
+    fs::remove(outputFile, ec);
+    std::string command = "BOX_PUSHING_JOB=\"" + fs::absolute(jobFile).string() + "\" " + opt.command + " > \"" +
+                          fs::absolute(jobFile).replace_extension(".log").string() + "\" 2>&1";
+    int status = std::system(command.c_str());
+
+    // atta exits with status 0 after a normal shutdown whatever the outcome of the job, the job finished if its output has the
+    // completion marker
+    std::ifstream in(outputFile);
+    json result = json::parse(in, nullptr, false);
+    if (!result.is_object() || !result.value("complete", false) || !result.contains("experiments")) {
+        std::cerr << "Job " << jobFile.string() << " failed (status " << status << "), counted as failed runs\n";
+        return costs;
+    }
+    const json& experiments = result["experiments"];
+    for (size_t i = 0; i < std::min(costs.size(), experiments.size()); i++) {
+        const json& reps = experiments[i]["repetitions"];
+        if (!reps.empty() && reps[0].value("success", false))
+            costs[i] = reps[0].value("time", failureCost);
+    }
+    return costs;
+}
+
+// Drop the candidates that are significantly worse than the best one, given paired costs
+void race(const Options& opt, std::vector<Candidate>& candidates) {
+    size_t best = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (candidates[i].alive && (!candidates[best].alive || candidates[i].mean() < candidates[best].mean()))
+            best = i;
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (!candidates[i].alive || i == best)
+            continue;
+        const size_t n = std::min(candidates[i].costs.size(), candidates[best].costs.size());
+        double mean = 0.0;
+        for (size_t k = 0; k < n; k++)
+            mean += candidates[i].costs[k] - candidates[best].costs[k];
+        mean /= n;
+        double var = 0.0;
+        for (size_t k = 0; k < n; k++) {
+            double d = candidates[i].costs[k] - candidates[best].costs[k] - mean;
+            var += d * d;
+        }
+        var = n > 1 ? var / (n - 1) : 0.0;
+        if (mean - opt.z * std::sqrt(var / n) > 0.0)
+            candidates[i].alive = false;
+    }
+}
+
+//---------- Sampling ----------//
+ControllerParams::Params sample(const ControllerParams::Params& center, float step, std::mt19937& rng) {
+    ControllerParams::Params params = center;
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    for (const ControllerParams::Info& info : ControllerParams::infos) {
+        float range = info.max - info.min;
+        params.*info.member = std::clamp(center.*info.member + normal(rng) * step * range, info.min, info.max);
+    }
+    return params;
+}
+
+ControllerParams::Params sampleUniform(std::mt19937& rng) {
+    ControllerParams::Params params;
+    for (const ControllerParams::Info& info : ControllerParams::infos)
+        params.*info.member = std::uniform_real_distribution<float>(info.min, info.max)(rng);
+    return params;
+}
+
+//---------- Main ----------//
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    for (std::string item; std::getline(ss, item, ',');)
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-c" && hasValue)
+            opt.command = argv[++i];
+        else if (arg == "-j" && hasValue)
+            opt.numJobs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "-n" && hasValue)
+            opt.numCandidates = std::max(2, std::atoi(argv[++i]));
+        else if (arg == "-g" && hasValue)
+            opt.numGenerations = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "-b" && hasValue)
+            opt.maxBlocks = std::max<int>(opt.minBlocks, std::atoi(argv[++i]));
+        else if (arg == "-m" && hasValue)
+            opt.maps = split(argv[++i]);
+        else if (arg == "-r" && hasValue)
+            opt.numRobots = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "-t" && hasValue)
+            opt.timeout = std::atof(argv[++i]);
+        else if (arg == "-s" && hasValue)
+            opt.seed = std::atoi(argv[++i]);
+        else if (arg == "-o" && hasValue)
+            opt.directory = argv[++i];
+        else {
+            std::cout << "Usage: " << argv[0] << " -c <simulation command> [-j jobs] [-n candidates] [-g generations] [-b blocks]\n"
+                      << "       [-m map,map,...] [-r robots] [-t timeout] [-s seed] [-o directory]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    if (opt.command.empty() || opt.maps.empty()) {
+        std::cerr << "A simulation command (-c) and at least one map (-m) are required\n";
+        return 1;
+    }
+    fs::create_directories(opt.directory);
+
+    std::ofstream log(opt.directory / "log.csv");
+    log << "generation,candidate,runs,meanCost,alive";
+    for (const ControllerParams::Info& info : ControllerParams::infos)
+        log << "," << info.name;
+    log << "\n";
+
+    std::mt19937 rng(opt.seed);
+    Candidate incumbent; // Paper defaults
+    float step = opt.initialStep;
+    for (unsigned g = 0; g < opt.numGenerations; g++, step *= opt.stepDecay) {
+        // The incumbent keeps its costs, the blocks use the same seeds in every generation
+        std::vector<Candidate> candidates = {incumbent};
+        candidates[0].alive = true;
+        while (candidates.size() < opt.numCandidates) {
+            Candidate candidate;
+            candidate.params = g == 0 ? sampleUniform(rng) : sample(incumbent.params, step, rng);
+            candidates.push_back(candidate);
+        }
+
+        fs::path genDir = opt.directory / ("generation_" + std::to_string(g));
+        fs::create_directories(genDir);
+        for (unsigned b = 0; b < opt.maxBlocks; b++) {
+            // Evaluate the block for the alive candidates in parallel
+            std::vector<size_t> pending;
+            for (size_t i = 0; i < candidates.size(); i++)
+                if (candidates[i].alive && candidates[i].costs.size() < (b + 1) * opt.maps.size())
+                    pending.push_back(i);
+            std::vector<std::vector<double>> costs(pending.size());
+            std::atomic<size_t> next = 0;
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < std::min<size_t>(opt.numJobs, pending.size()); t++)
+                workers.emplace_back([&]() {
+                    for (size_t k = next++; k < pending.size(); k = next++) {
+                        fs::path jobFile = genDir / ("candidate_" + std::to_string(pending[k]) + "-block_" + std::to_string(b) + ".json");
+                        costs[k] = evaluate(opt, candidates[pending[k]], jobFile, b);
+                    }
+                });
+            for (std::thread& w : workers)
+                w.join();
+            for (size_t k = 0; k < pending.size(); k++)
+                candidates[pending[k]].costs.insert(candidates[pending[k]].costs.end(), costs[k].begin(), costs[k].end());
+
+            size_t numAlive = 0;
+            if (b + 1 >= opt.minBlocks)
+                race(opt, candidates);
+            for (const Candidate& c : candidates)
+                numAlive += c.alive;
+            std::cerr << "Generation " << g << " block " << b << ": " << numAlive << " candidates left\n";
+            if (numAlive == 1)
+                break;
+        }
+
+        // The best surviving candidate becomes the incumbent
+        size_t best = 0;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            const Candidate& c = candidates[i];
+            if (c.alive && (!candidates[best].alive || c.mean() < candidates[best].mean()))
+                best = i;
+            log << g << "," << i << "," << c.costs.size() << "," << c.mean() << "," << c.alive;
+            for (const ControllerParams::Info& info : ControllerParams::infos)
+                log << "," << c.params.*info.member;
+            log << "\n";
+        }
+        log.flush();
+        incumbent = candidates[best];
+        std::cerr << "Generation " << g << ": best mean cost " << incumbent.mean() << " s (candidate " << best << ")\n";
+
+        json bestJson = ControllerParams::toJson(incumbent.params);
+        std::ofstream(opt.directory / "best.json") << bestJson.dump(4);
+    }
+
+    std::cout << ControllerParams::toJson(incumbent.params).dump(4) << "\n";
+    std::cerr << "Best parameters saved to " << (opt.directory / "best.json").string() << "\n";
+    return 0;
+}